@@ -0,0 +1,72 @@
+// The last post processing pass, from the frame to the window. Applies the
+// vignette mask and its shadow, then desaturates. Loaded a second time with
+// BLUR defined, which also applies the horizontal half of blur.frag.
+uniform sampler2D texture;
+uniform sampler2D vignette;
+uniform sampler2D vignetteShadow;
+// Where each vignette texture sits on the frame, as x, y, width, height in
+// zero to one, top down
+uniform vec4 vignetteRect;
+uniform vec4 shadowRect;
+uniform vec4 vignetteColor;
+uniform vec4 shadowColor;
+uniform float amount;
+#ifdef BLUR
+uniform vec2 blur_radius;
+#endif
+
+vec4 sampleFrame(vec2 coord) {
+#ifdef BLUR
+	vec4 color = vec4(0.0);
+	color += texture2D(texture, coord - 10.0 * blur_radius) * 0.0175;
+	color += texture2D(texture, coord - 9.0 * blur_radius) * 0.0222;
+	color += texture2D(texture, coord - 8.0 * blur_radius) * 0.0266;
+	color += texture2D(texture, coord - 7.0 * blur_radius) * 0.0299;
+	color += texture2D(texture, coord - 6.0 * blur_radius) * 0.0388;
+	color += texture2D(texture, coord - 5.0 * blur_radius) * 0.0484;
+	color += texture2D(texture, coord - 4.0 * blur_radius) * 0.0579;
+	color += texture2D(texture, coord - 3.0 * blur_radius) * 0.0666;
+	color += texture2D(texture, coord - 2.0 * blur_radius) * 0.0737;
+	color += texture2D(texture, coord - blur_radius) * 0.0782;
+	color += texture2D(texture, coord) * 0.0798;
+	color += texture2D(texture, coord + blur_radius) * 0.0782;
+	color += texture2D(texture, coord + 2.0 * blur_radius) * 0.0737;
+	color += texture2D(texture, coord + 3.0 * blur_radius) * 0.0666;
+	color += texture2D(texture, coord + 4.0 * blur_radius) * 0.0579;
+	color += texture2D(texture, coord + 5.0 * blur_radius) * 0.0484;
+	color += texture2D(texture, coord + 6.0 * blur_radius) * 0.0388;
+	color += texture2D(texture, coord + 7.0 * blur_radius) * 0.0299;
+	color += texture2D(texture, coord + 8.0 * blur_radius) * 0.0266;
+	color += texture2D(texture, coord + 9.0 * blur_radius) * 0.0222;
+	color += texture2D(texture, coord + 10.0 * blur_radius) * 0.0175;
+	return color;
+#else
+	return texture2D(texture, coord);
+#endif
+}
+
+bool inside(vec2 coord) {
+	return all(greaterThanEqual(coord, vec2(0.0))) &&
+	       all(lessThanEqual(coord, vec2(1.0)));
+}
+
+void main() {
+	vec2 coord = gl_TexCoord[0].xy;
+	vec4 pixel = sampleFrame(coord);
+	// The frame is a render texture, which is stored bottom up
+	vec2 position = vec2(coord.x, 1.0 - coord.y);
+	// Same as drawing the mask with sf::BlendMultiply
+	vec2 maskCoord = (position - vignetteRect.xy) / vignetteRect.zw;
+	if (inside(maskCoord)) {
+		pixel *= texture2D(vignette, maskCoord) * vignetteColor;
+	}
+	// And the shadow with sf::BlendAlpha
+	vec2 shadowCoord = (position - shadowRect.xy) / shadowRect.zw;
+	if (inside(shadowCoord)) {
+		vec4 shadow = texture2D(vignetteShadow, shadowCoord) * shadowColor;
+		pixel.rgb = mix(pixel.rgb, shadow.rgb, shadow.a);
+		pixel.a = shadow.a + pixel.a * (1.0 - shadow.a);
+	}
+	vec3 gray = vec3(dot(vec3(0.2126, 0.7152, 0.0722), pixel.rgb));
+	gl_FragColor = vec4(mix(pixel.rgb, gray, amount), pixel.a);
+}
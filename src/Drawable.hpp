@@ -4,20 +4,6 @@
 #include "framework/framework.hpp"
 #include <type_traits>
 
-template <size_t margin = 128, typename T>
-bool isWithinView(const T & target, const sf::View & view) {
-    const sf::Vector2f targetPos = target.getPosition();
-    const sf::Vector2f viewCenter = view.getCenter();
-    const sf::Vector2f viewSize = view.getSize();
-    if (targetPos.x > viewCenter.x - viewSize.x / 2 - margin &&
-        targetPos.x < viewCenter.x + viewSize.x / 2 + margin &&
-        targetPos.y > viewCenter.y - viewSize.y / 2 - margin &&
-        targetPos.y < viewCenter.y + viewSize.y / 2 + margin) {
-        return true;
-    }
-    return false;
-}
-
 struct ForceMain {
     using value_type = int;
     template <typename CallerType> void run(CallerType & ct, GfxContext & gfx) {
@@ -84,10 +70,11 @@ template <typename... Args> struct RenderPolicy : public Wrapper<Args>... {
     // RenderPolicy() : Wrapper<Args>{}... {} FIXME: Microsoft compiler
     // complains about this... is this even necessary, if implicitly default
     // constructible?
+    // Only draws objects that the last VisibilitySet::build() found near
+    // the view
     template <typename CallerType>
-    void draw(const CallerType & ct, GfxContext & gfxContext,
-              const sf::View & view) {
-        if (isWithinView(ct, view)) {
+    void draw(const CallerType & ct, GfxContext & gfxContext) {
+        if (ct.isVisible()) {
             call<CallerType, Args...>(ct, gfxContext);
         }
     }
@@ -104,7 +91,7 @@ template <typename... Args> struct RenderPolicy : public Wrapper<Args>... {
 template <typename Base, typename DrawPolicy>
 class Drawable : private DrawPolicy {
 public:
-    void draw(GfxContext & gfxContext, const sf::View & view) {
-        DrawPolicy::draw(*static_cast<Base *>(this), gfxContext, view);
+    void draw(GfxContext & gfxContext) {
+        DrawPolicy::draw(*static_cast<Base *>(this), gfxContext);
     }
 };
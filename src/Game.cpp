@@ -1,26 +1,21 @@
 #include "Game.hpp"
 #include "ResourcePath.hpp"
 #include "easingTemplates.hpp"
-#include "enemyPlacementFn.hpp"
-#include "initMapVectors.hpp"
-#include "lightingMap.hpp"
-#include "mappingFunctions.hpp"
 #include "math.h"
-#include "pillarPlacement.h"
 
-Game::Game(nlohmann::json & config)
-    : hasFocus(true), viewPort(getDrawableArea(config)),
+Game::Game(nlohmann::json & config, sf::RenderWindow & _window)
+    : hasFocus(true), levelSwapPending(false), replayMode(false),
+      closing(false), profilerHotkey(false), profilerOverlayVisible(false),
+      viewPort(getDrawableArea(config)),
       transitionState(TransitionState::TransitionIn),
-      player(viewPort.x / 2, viewPort.y / 2),
-      window(sf::VideoMode::getDesktopMode(), EXECUTABLE_NAME,
-             sf::Style::Fullscreen, sf::ContextSettings(0, 0, 6)),
-      input(config), camera(&player, viewPort, window.getSize()),
+      player(viewPort.x / 2, viewPort.y / 2), window(_window), input(config),
+      camera(&player, viewPort, window.getSize()),
       uiFrontend(
           sf::View(sf::FloatRect(0, 0, window.getSize().x, window.getSize().y)),
           viewPort.x / 2, viewPort.y / 2),
       level(0), stashed(false), preload(false),
       worldView(sf::Vector2f(viewPort.x / 2, viewPort.y / 2), viewPort),
-      timer(0) {
+      resolution(config, viewPort), timer(0) {
     sf::View windowView;
     static const float visibleArea = 0.75f;
     const sf::Vector2f vignetteMaskScale(
@@ -31,20 +26,13 @@ Game::Game(nlohmann::json & config)
     windowView.setSize(window.getSize().x, window.getSize().y);
     windowView.zoom(visibleArea);
     camera.setWindowView(windowView);
-    gfxContext.targetRef = &target;
     window.requestFocus();
     init();
 }
 
 void Game::init() {
-    target.create(viewPort.x, viewPort.y);
-    secondPass.create(viewPort.x, viewPort.y);
-    secondPass.setSmooth(true);
-    thirdPass.create(viewPort.x, viewPort.y);
-    thirdPass.setSmooth(true);
     stash.create(viewPort.x, viewPort.y);
     stash.setSmooth(true);
-    lightingMap.create(viewPort.x, viewPort.y);
     vignetteSprite.setTexture(
         getgResHandlerPtr()->getTexture(ResHandler::Texture::vignette));
     vignetteShadowSpr.setTexture(
@@ -62,39 +50,82 @@ void Game::init() {
     transitionShape.setSize(sf::Vector2f(viewPort.x, viewPort.y));
     transitionShape.setFillColor(sf::Color(0, 0, 0, 0));
     vignetteSprite.setColor(sf::Color::White);
-    window.setVerticalSyncEnabled(true);
-    window.setFramerateLimit(120);
-    window.setMouseCursorVisible(false);
     level = -1;
     this->nextLevel();
 }
 
 void Game::eventLoop() {
+    pumpEvents();
+    sf::Event event;
+    // Suspended until the window gets its focus back. The logic thread is
+    // waiting in waitForFocus() meanwhile.
+    while (!hasFocus && window.waitEvent(event)) {
+        handleEvent(event);
+    }
+}
+
+void Game::pumpEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
-        switch (event.type) {
-        case sf::Event::Closed:
-            window.close();
-            throw ShutdownSignal();
-            break;
-
-        case sf::Event::GainedFocus:
-	    hasFocus = true;
-            sounds.unpause(SoundController::Sound | SoundController::Music);
-            break;
-
-        case sf::Event::LostFocus:
-	    hasFocus = false;
-            sounds.pause(SoundController::Sound | SoundController::Music);
-            break;
-
-        default:
-            input.recordEvent(event);
-            break;
+        handleEvent(event);
+    }
+}
+
+void Game::handleEvent(const sf::Event & event) {
+    switch (event.type) {
+    case sf::Event::Closed: {
+        // Lets the logic thread out of waitForFocus() and waitForLevelSwap().
+        // Setting the flag under the lock means the logic thread either sees
+        // it before it waits, or is already waiting when notified.
+        {
+            std::lock_guard<std::mutex> lk(focusMutex);
+            closing = true;
+            focusCond.notify_all();
+        }
+        {
+            std::lock_guard<std::mutex> lk(transitionMutex);
+            swapCond.notify_all();
+        }
+        window.close();
+        throw ShutdownSignal();
+    }
+
+    case sf::Event::GainedFocus: {
+        std::lock_guard<std::mutex> lk(focusMutex);
+        hasFocus = true;
+        focusCond.notify_all();
+        sounds.unpause(SoundController::Sound | SoundController::Music);
+    } break;
+
+    case sf::Event::LostFocus:
+        hasFocus = false;
+        sounds.pause(SoundController::Sound | SoundController::Music);
+        break;
+
+    case sf::Event::KeyPressed:
+        logicScheduler.wake();
+        if (profilerHotkey && event.key.code == sf::Keyboard::F3) {
+            profilerOverlayVisible = !profilerOverlayVisible;
+            // A trace being recorded keeps the timers running
+            if (!profiler::isTracing()) {
+                profiler::setEnabled(profilerOverlayVisible);
+            }
         }
+        input.recordEvent(event);
+        break;
+
+    default:
+        logicScheduler.wake();
+        input.recordEvent(event);
+        break;
     }
 }
 
+void Game::waitForFocus() {
+    std::unique_lock<std::mutex> lk(focusMutex);
+    focusCond.wait(lk, [this] { return hasFocus || closing; });
+}
+
 void Game::drawTransitions(sf::RenderWindow & window) {
     std::lock_guard<std::mutex> grd(transitionMutex);
     switch (transitionState) {
@@ -127,13 +158,8 @@ void Game::drawTransitions(sf::RenderWindow & window) {
                 transitionShape.setFillColor(sf::Color(0, 0, 0, alpha));
                 window.draw(transitionShape);
             }
-            if (timer > 1000000) {
-                transitionState = TransitionState::TransitionIn;
-                timer = 0;
-                transitionShape.setFillColor(sf::Color(0, 0, 0, 255));
-                beamGlowSpr.setColor(sf::Color::Black);
-                this->nextLevel(); // Creates textures, needs to happen on main
-                                   // thread
+            if (levelSwapPending) {
+                swapLevel(); // Creates textures, needs to happen on main thread
             }
         } else {
             if (timer > 1600000) {
@@ -149,12 +175,8 @@ void Game::drawTransitions(sf::RenderWindow & window) {
             } else {
                 uiFrontend.drawTitle(255, window);
             }
-            if (timer > 3000000) {
-                transitionState = TransitionState::TransitionIn;
-                beamGlowSpr.setColor(sf::Color::Black);
-                timer = 0;
-                transitionShape.setFillColor(sf::Color(0, 0, 0, 255));
-                this->nextLevel();
+            if (levelSwapPending) {
+                swapLevel();
             }
         }
         break;
@@ -264,7 +286,10 @@ void Game::updateTransitions(const sf::Time & elapsedTime) {
 
     case TransitionState::TransitionOut:
         timer += elapsedTime.asMicroseconds();
-        // Logic updates instead when drawing transitions, see above comment.
+        // The swap itself happens when drawing transitions, see above comment.
+        if (timer > (level != 0 ? 1000000 : 3000000)) {
+            levelSwapPending = true;
+        }
         break;
 
     case TransitionState::TransitionIn:
@@ -300,7 +325,7 @@ void Game::updateTransitions(const sf::Time & elapsedTime) {
                 transitionState = TransitionState::EntryBeamFade;
                 timer = 0;
                 player.visible = true;
-                util::sleep(milliseconds(20));
+                hitStop.start(sf::milliseconds(20));
                 camera.shake(0.19f);
             }
         }
@@ -326,12 +351,46 @@ void Game::updateTransitions(const sf::Time & elapsedTime) {
     }
 }
 
+void Game::swapLevel() {
+    transitionState = TransitionState::TransitionIn;
+    timer = 0;
+    transitionShape.setFillColor(sf::Color(0, 0, 0, 255));
+    beamGlowSpr.setColor(sf::Color::Black);
+    this->nextLevel();
+    levelSwapPending = false;
+    swapCond.notify_all();
+}
+
+void Game::swapLevelIfPending() {
+    std::lock_guard<std::mutex> grd(transitionMutex);
+    if (levelSwapPending) {
+        swapLevel();
+    }
+}
+
+bool Game::isLevelSwapPending() const { return levelSwapPending; }
+
+void Game::waitForLevelSwap() {
+    std::unique_lock<std::mutex> lk(transitionMutex);
+    swapCond.wait(lk, [this] { return !levelSwapPending || closing; });
+}
+
+bool Game::hasWindowFocus() const { return hasFocus; }
+
+void Game::setReplayMode(bool enabled) { replayMode = enabled; }
+
+void Game::setProfilerHotkeyEnabled(bool enabled) { profilerHotkey = enabled; }
+
 void Game::nextLevel() {
     ++level;
+    // Each level's layout depends only on the run seed and the level number
+    rng::reseed(rng::Stream::mapgen, level);
     uiFrontend.setWaypointText(level);
     tiles.clear();
     effectGroup.clear();
+    particles.clear();
     detailGroup.clear();
+    hitStop.reset();
     player.setPosition(viewPort.x / 2 - 17, viewPort.y / 2);
     en.clear();
     if (level == 0) {
@@ -342,12 +401,13 @@ void Game::nextLevel() {
         set = tileController::Tileset::regular;
     }
     if (set != tileController::Tileset::intro) {
-        int count;
-        do {
-            count = generateMap(tiles.mapArray);
-        } while (count < 150);
+        auto prepared = prefetcher.take(level);
+        layout = std::move(prepared->layout);
+        rng::get(rng::Stream::mapgen) = prepared->generator;
+        tiles.rebuild(set, layout, std::move(prepared->art));
+    } else {
+        tiles.rebuild(set, layout, {});
     }
-    tiles.rebuild(set);
     bkg.setBkg(static_cast<uint8_t>(set));
     tiles.setPosition((viewPort.x / 2) - 16, (viewPort.y / 2));
     helperGroup.apply([this](auto & vec) {
@@ -358,19 +418,6 @@ void Game::nextLevel() {
         }
     });
     bkg.setPosition((tiles.posX / 2) + 206, tiles.posY / 2);
-    auto pickLocation =
-        [](std::vector<Coordinate> & emptyLocations) -> option<Coordinate> {
-        if (emptyLocations.size() > 0) {
-            int locationSelect = rng::random(emptyLocations.size());
-            Coordinate c = emptyLocations[locationSelect];
-            emptyLocations[locationSelect] = emptyLocations.back();
-            emptyLocations.pop_back();
-            return option<Coordinate>(c);
-        } else {
-            return {};
-        }
-    };
-    auto emptyOncreate = [](auto created) {};
     if (level != 0) {
         Coordinate c = tiles.getTeleporterLoc();
         detailGroup.add<DetailRef::Teleporter>(
@@ -378,66 +425,59 @@ void Game::nextLevel() {
             getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
             getgResHandlerPtr()->getTexture(
                 ResHandler::Texture::teleporterGlow));
-        initEnemies(this);
-        auto optCoord = pickLocation(tiles.emptyMapLocations);
-        if (optCoord) {
-            Powerup chestContents;
-            if (level < 7) {
-                chestContents = static_cast<Powerup>(rng::random<2, 1>());
-            } else {
-                chestContents = static_cast<Powerup>(rng::random<3, 2>());
+        for (const auto & spawn : layout.enemies) {
+            switch (spawn.kind) {
+            case EnemyKind::Scoot:
+                en.addScoot(&tiles, spawn.position);
+                break;
+
+            case EnemyKind::Critter:
+                en.addCritter(&tiles, spawn.position);
+                break;
+
+            case EnemyKind::Dasher:
+                en.addDasher(&tiles, spawn.position);
+                break;
+
+            case EnemyKind::Turret:
+                en.addTurret(&tiles, spawn.position);
+                break;
             }
+        }
+        if (layout.hasChest) {
             detailGroup.add<DetailRef::TreasureChest>(
-                optCoord.value().x * 32 + tiles.posX,
-                optCoord.value().y * 26 + tiles.posY,
+                layout.chest.x * 32 + tiles.posX,
+                layout.chest.y * 26 + tiles.posY,
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
-                chestContents);
+                layout.chestContents);
         }
-        if (!rng::random<2>()) {
-            auto pCoordVec = tiles.getEmptyLocations();
-            const size_t vecSize = pCoordVec->size();
-            const int locationSel = rng::random(vecSize / 3);
-            const int xInit = (*pCoordVec)[vecSize - 1 - locationSel].x;
-            const int yInit = (*pCoordVec)[vecSize - 1 - locationSel].y;
+        if (layout.hasTerminal) {
+            const int xInit = layout.terminal.x;
+            const int yInit = layout.terminal.y;
             detailGroup.add<DetailRef::Terminal>(
                 xInit * 32 + tiles.posX, yInit * 26 + tiles.posY,
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
-                tiles.mapArray[xInit][yInit]);
+                tiles.mapArray(xInit, yInit));
         }
         gfxContext.glowSprs1.clear();
         gfxContext.glowSprs2.clear();
-        Circle teleporterFootprint;
-        teleporterFootprint.x = tiles.getTeleporterLoc().x;
-        teleporterFootprint.y = tiles.getTeleporterLoc().y;
-        teleporterFootprint.r = 50;
-        std::vector<Coordinate> detailPositions;
-        if (set == tileController::Tileset::regular) {
-            getRockPositions(tiles.mapArray, detailPositions,
-                             teleporterFootprint);
-            for (auto element : detailPositions) {
-                detailGroup.add<DetailRef::Rock>(
-                    tiles.posX + 32 * element.x,
-                    tiles.posY + 26 * element.y - 35,
-                    getgResHandlerPtr()->getTexture(
-                        ResHandler::Texture::gameObjects));
-            }
-            detailPositions.clear();
+        for (auto element : layout.rockPositions) {
+            detailGroup.add<DetailRef::Rock>(
+                tiles.posX + 32 * element.x, tiles.posY + 26 * element.y - 35,
+                getgResHandlerPtr()->getTexture(
+                    ResHandler::Texture::gameObjects));
         }
-        getLightingPositions(tiles.mapArray, detailPositions,
-                             teleporterFootprint);
-        const size_t len = detailPositions.size();
-        for (size_t i = 0; i < len; i++) {
+        for (auto element : layout.lightPositions) {
             detailGroup.add<DetailRef::Lamp>(
-                tiles.posX + 16 + (detailPositions[i].x * 32),
-                tiles.posY - 3 + (detailPositions[i].y * 26),
+                tiles.posX + 16 + (element.x * 32),
+                tiles.posY - 3 + (element.y * 26),
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::lamplight));
         }
-        detailPositions.clear();
     } else if (set == tileController::Tileset::intro) {
         detailGroup.add<DetailRef::Lamp>(
             tiles.posX - 180 + 16 + (5 * 32), tiles.posY + 200 - 3 + (6 * 26),
@@ -480,7 +520,10 @@ void Game::nextLevel() {
             w.setYinit(it->second);
             tiles.walls.push_back(w);
         }
+        tiles.indexWalls();
     }
+    // Get going on the next level while this one is played
+    prefetcher.request(level + 1);
 }
 
 DetailGroup & Game::getDetails() { return detailGroup; }
@@ -489,6 +532,17 @@ HelperGroup & Game::getHelperGroup() { return helperGroup; }
 
 enemyController & Game::getEnemyController() { return en; }
 
+HitStop & Game::getHitStop() { return hitStop; }
+
+DynamicResolution & Game::getDynamicResolution() { return resolution; }
+
+LogicScheduler & Game::getLogicScheduler() { return logicScheduler; }
+
+bool Game::isIdle() const {
+    // Matches the test at the top of updateLogic()
+    return stashed && !preload && !replayMode;
+}
+
 tileController & Game::getTileController() { return tiles; }
 
 Player & Game::getPlayer() { return player; }
@@ -497,6 +551,8 @@ Camera & Game::getCamera() { return camera; }
 
 EffectGroup & Game::getEffects() { return effectGroup; }
 
+ParticleSystem & Game::getParticles() { return particles; }
+
 InputController & Game::getInputController() { return input; }
 
 ui::Backend & Game::getUI() { return UI; }
@@ -9,19 +9,27 @@
 #include "backgroundHandler.hpp"
 #include "camera.hpp"
 #include "colors.hpp"
+#include "dynamicResolution.hpp"
 #include "effectsController.hpp"
 #include "enemyController.hpp"
 #include "framework/option.hpp"
+#include "hitStop.hpp"
 #include "inputController.hpp"
+#include "levelPrefetcher.hpp"
+#include "particles.hpp"
+#include "logicScheduler.hpp"
 #include "player.hpp"
+#include "profiler.hpp"
 #include "resourceHandler.hpp"
 #include "soundController.hpp"
 #include "tileController.hpp"
 #include "userInterface.hpp"
+#include "visibility.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <mutex>
 
 class Game {
@@ -36,17 +44,45 @@ public:
         EntryBeamDrop,
         EntryBeamFade
     };
-    Game(nlohmann::json & json);
+    Game(nlohmann::json & json, sf::RenderWindow & window);
     void updateLogic(const sf::Time &);
     void updateGraphics();
     void eventLoop();
     void nextLevel();
+    // Level swaps create textures, which has to happen on the main thread.
+    // When a level ends, the logic thread flags the swap and shouldn't tick
+    // again until the main thread has called swapLevelIfPending(), which
+    // keeps the number of ticks between levels independent of the frame
+    // rate.
+    bool isLevelSwapPending() const;
+    void swapLevelIfPending();
+    // Blocks the calling thread until the pending level swap is done, or
+    // the window is closed
+    void waitForLevelSwap();
+    bool hasWindowFocus() const;
+    // Blocks the calling thread until the window has focus again, or is
+    // closed. While the window is out of focus, eventLoop() blocks the main
+    // thread too, so a backgrounded game uses no CPU at all.
+    void waitForFocus();
+    // True while nothing in the overworld is simulating, e.g. behind a
+    // stashed menu, so that the logic thread can tick less often
+    bool isIdle() const;
+    LogicScheduler & getLogicScheduler();
+    // While recording or playing back a replay, the world keeps updating
+    // behind a stashed menu frame, because when a frame gets stashed depends
+    // on the renderer.
+    void setReplayMode(bool enabled);
+    // Lets F3 show and hide the profiler overlay
+    void setProfilerHotkeyEnabled(bool enabled);
     int getLevel();
     DetailGroup & getDetails();
     enemyController & getEnemyController();
+    HitStop & getHitStop();
+    DynamicResolution & getDynamicResolution();
     tileController & getTileController();
     Player & getPlayer();
     EffectGroup & getEffects();
+    ParticleSystem & getParticles();
     SoundController & getSounds();
     InputController & getInputController();
     ui::Backend & getUI();
@@ -56,23 +92,45 @@ public:
     TransitionState transitionState;
     sf::RenderWindow & getWindow();
     HelperGroup & getHelperGroup();
+    // Flags the overworld's objects near the view, for the next tick's
+    // culling and the next frame's drawing. updateLogic() calls it, anything
+    // else must hold off the logic thread.
+    void updateVisibility();
 
 private:
     void init();
-    bool hasFocus;
-    sf::RenderWindow window;
+    void swapLevel();
+    void postProcess(DynamicResolution::Targets &);
+    sf::Shader & getCompositeShader(bool blur, float desaturate);
+    void pumpEvents();
+    void handleEvent(const sf::Event &);
+    std::atomic<bool> hasFocus, levelSwapPending;
+    bool replayMode;
+    // Set once the window is closed, read under focusMutex or
+    // transitionMutex
+    std::atomic<bool> closing;
+    bool profilerHotkey, profilerOverlayVisible;
+    profiler::Overlay profilerOverlay;
+    sf::RenderWindow & window;
     InputController input;
     SoundController sounds;
     Player player;
     Camera camera;
     ui::Backend UI;
     tileController tiles;
+    LevelLayout layout;
+    LevelPrefetcher prefetcher;
     EffectGroup effectGroup;
+    ParticleSystem particles;
+    VisibilitySet visibility;
     DetailGroup detailGroup;
     HelperGroup helperGroup;
     enemyController en;
     ui::Frontend uiFrontend;
-    std::mutex overworldMutex, UIMutex, transitionMutex;
+    HitStop hitStop;
+    LogicScheduler logicScheduler;
+    std::mutex overworldMutex, UIMutex, transitionMutex, focusMutex;
+    std::condition_variable focusCond, swapCond;
     int level;
     bool stashed, preload;
     sf::Sprite vignetteSprite;
@@ -82,8 +140,8 @@ private:
     GfxContext gfxContext;
     sf::Sprite beamGlowSpr;
     sf::View worldView, hudView;
-    sf::RenderTexture lightingMap;
-    sf::RenderTexture target, secondPass, thirdPass, stash;
+    DynamicResolution resolution;
+    sf::RenderTexture stash;
     sf::RectangleShape transitionShape, beamShape;
     void updateTransitions(const sf::Time &);
     void drawTransitions(sf::RenderWindow &);
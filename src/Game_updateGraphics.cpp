@@ -1,38 +1,69 @@
 #include "Game.hpp"
+#include "profiler.hpp"
+#include <cstdio>
 
 void Game::updateGraphics() {
+    // A press that the logic thread has already reacted to, which shows up
+    // on screen with this frame
+    const int64_t press = input.takeReflectedPress();
+    DynamicResolution::Targets & frame = resolution.beginFrame();
+    sf::RenderTexture & target = frame.scene;
+    sf::RenderTexture & lightingMap = frame.lighting;
+    gfxContext.targetRef = &target;
     window.clear();
-    if (!hasFocus) {
-        util::sleep(milliseconds(200));
-        return;
-    }
     target.clear(sf::Color::Transparent);
     if (!stashed || preload) {
         {
             std::lock_guard<std::mutex> overworldLock(overworldMutex);
             lightingMap.setView(camera.getOverworldView());
-            bkg.drawBackground(target, worldView, camera);
-            tiles.draw(target, &gfxContext.glowSprs1, level, worldView,
-                       camera.getOverworldView());
+            {
+                profiler::Scope scope(profiler::Stage::drawBackground);
+                bkg.drawBackground(target, worldView, camera);
+            }
+            // Before the tiles, which draw the particles' glows on the floor
+            particles.prepare(camera.getOverworldView());
+            {
+                profiler::Scope scope(profiler::Stage::drawTiles);
+                tiles.draw(target, &gfxContext.glowSprs1,
+                           particles.getGlows(), level, worldView,
+                           camera.getOverworldView());
+            }
+            profiler::Scope scope(profiler::Stage::drawObjects);
             gfxContext.glowSprs2.clear();
             gfxContext.glowSprs1.clear();
             gfxContext.shadows.clear();
             gfxContext.faces.clear();
+            gfxContext.trails.clear();
             target.setView(camera.getOverworldView());
             auto drawPolicy = [this](auto & vec) {
                 for (auto it = vec.begin(); it != vec.end(); ++it) {
-                    it->get()->draw(gfxContext, camera.getOverworldView());
+                    it->get()->draw(gfxContext);
                 }
             };
             detailGroup.apply(drawPolicy);
             if (player.visible) {
-                player.draw(gfxContext.faces, gfxContext.shadows);
+                player.draw(gfxContext.faces, gfxContext.shadows,
+                            gfxContext.trails);
             }
             effectGroup.apply(drawPolicy);
             helperGroup.apply(drawPolicy);
-            en.draw(gfxContext.faces, gfxContext.shadows, camera);
+            en.draw(gfxContext.faces, gfxContext.shadows, gfxContext.trails);
             sounds.update();
         }
+        const SpriteBatch & particleSprites = particles.getSprites();
+        const SpriteBatch & particleGlows = particles.getGlows();
+        profiler::count(profiler::Counter::drawCalls,
+                        gfxContext.shadows.size() + gfxContext.faces.size() +
+                            gfxContext.glowSprs2.size() +
+                            gfxContext.trails.getBatchCount() +
+                            particleSprites.getBatchCount() +
+                            particleGlows.getBatchCount());
+        profiler::count(profiler::Counter::sprites,
+                        gfxContext.shadows.size() + gfxContext.faces.size() +
+                            gfxContext.glowSprs2.size() +
+                            gfxContext.trails.getQuadCount() +
+                            particleSprites.getQuadCount() +
+                            particleGlows.getQuadCount());
         if (!gfxContext.shadows.empty()) {
             for (const auto & element : gfxContext.shadows) {
                 target.draw(std::get<0>(element));
@@ -40,16 +71,22 @@ void Game::updateGraphics() {
         }
         target.setView(worldView);
         lightingMap.clear(sf::Color::Transparent);
-        static const size_t zOrderIdx = 1;
-        std::sort(
-            gfxContext.faces.begin(), gfxContext.faces.end(),
-            [](const drawableMetadata & arg1, const drawableMetadata & arg2) {
-                return (std::get<zOrderIdx>(arg1) < std::get<zOrderIdx>(arg2));
-            });
+        {
+            profiler::Scope scope(profiler::Stage::drawFaceSort);
+            static const size_t zOrderIdx = 1;
+            std::sort(gfxContext.faces.begin(), gfxContext.faces.end(),
+                      [](const drawableMetadata & arg1,
+                         const drawableMetadata & arg2) {
+                          return (std::get<zOrderIdx>(arg1) <
+                                  std::get<zOrderIdx>(arg2));
+                      });
+        }
+        profiler::Scope lightingScope(profiler::Stage::drawLighting);
         static const size_t sprIdx = 0;
         static const size_t shaderIdx = 3;
         sf::Shader & colorShader =
             getgResHandlerPtr()->getShader(ResHandler::Shader::color);
+        lightingMap.draw(gfxContext.trails);
         for (auto & element : gfxContext.faces) {
             switch (std::get<2>(element)) {
             case Rendertype::shadeDefault:
@@ -78,6 +115,9 @@ void Game::updateGraphics() {
                 COLOR_LABEL(Electric, shadeElectric);
             }
         }
+        // Particles go on top of everything else, they never stay around
+        // long enough for the ordering to be noticeable
+        lightingMap.draw(particleSprites);
         static const sf::Color blendAmount(185, 185, 185);
         sf::Sprite tempSprite;
         for (auto & element : gfxContext.glowSprs2) {
@@ -89,37 +129,125 @@ void Game::updateGraphics() {
                                  sf::BlendMode::Zero, sf::BlendMode::Add)));
         }
         lightingMap.display();
-        target.draw(sf::Sprite(lightingMap.getTexture()));
+        // The lighting map is the same size as the target, which may be
+        // smaller than the view
+        sf::Sprite lightingSprite(lightingMap.getTexture());
+        lightingSprite.setScale(viewPort.x / target.getSize().x,
+                                viewPort.y / target.getSize().y);
+        target.draw(lightingSprite);
         target.setView(camera.getOverworldView());
         bkg.drawForeground(target);
         target.setView(worldView);
         sf::Vector2f fgMaskPos(
             viewPort.x * 0.115f + camera.getOffsetFromTarget().x * 0.75f,
             viewPort.y * 0.115f + camera.getOffsetFromTarget().y * 0.75f);
+        // The vignette itself is applied by postProcess()
         vignetteSprite.setPosition(fgMaskPos);
         vignetteShadowSpr.setPosition(fgMaskPos);
-        target.draw(vignetteSprite, sf::BlendMultiply);
-        target.draw(vignetteShadowSpr);
         target.display();
     }
+    {
+        profiler::Scope scope(profiler::Stage::drawPostProcess);
+        postProcess(frame);
+    }
+    {
+        std::lock_guard<std::mutex> UILock(UIMutex);
+        profiler::Scope scope(profiler::Stage::drawUI);
+        if (player.getState() == Player::State::dead) {
+            UI.draw(window, uiFrontend);
+        } else {
+            if (transitionState == TransitionState::None) {
+                UI.draw(window, uiFrontend);
+            }
+            uiFrontend.draw(window);
+        }
+    }
+    window.setView(worldView);
+    {
+        profiler::Scope scope(profiler::Stage::drawTransitions);
+        drawTransitions(window);
+    }
+    if (profilerOverlayVisible) {
+        const InputController::LatencyStats latency = input.getLatencyStats();
+        char status[160];
+        std::snprintf(status, sizeof(status),
+                      "logic: %.0f ticks/s, %.0f%% busy\n"
+                      "input to present: %.1f ms avg, %.1f ms max\n"
+                      "resolution: %.0f%%",
+                      logicScheduler.getTicksPerSecond(),
+                      logicScheduler.getBusyPercent(), latency.meanMillis,
+                      latency.maxMillis, resolution.getScale() * 100.f);
+        profilerOverlay.update(status);
+        profilerOverlay.draw(window);
+    }
+    resolution.endFrame();
+    // Events that came in while drawing reach the logic thread now, rather
+    // than after display() returns, which may block for the rest of the
+    // frame with vsync on
+    pumpEvents();
+    window.display();
+    resolution.framePresented();
+    input.framePresented(press);
+}
+
+// Where a sprite drawn with the world view lands on the frame, from zero to one
+static sf::Glsl::Vec4 frameRect(const sf::Sprite & sprite,
+                                const sf::Vector2f & viewPort) {
+    const sf::FloatRect bounds = sprite.getGlobalBounds();
+    return sf::Glsl::Vec4(bounds.left / viewPort.x, bounds.top / viewPort.y,
+                          bounds.width / viewPort.x,
+                          bounds.height / viewPort.y);
+}
+
+sf::Shader & Game::getCompositeShader(bool blur, float desaturate) {
+    sf::Shader & shader = getgResHandlerPtr()->getShader(
+        blur ? ResHandler::Shader::compositeBlur
+             : ResHandler::Shader::composite);
+    shader.setUniform("vignette", *vignetteSprite.getTexture());
+    shader.setUniform("vignetteShadow", *vignetteShadowSpr.getTexture());
+    shader.setUniform("vignetteRect", frameRect(vignetteSprite, viewPort));
+    shader.setUniform("shadowRect", frameRect(vignetteShadowSpr, viewPort));
+    shader.setUniform("vignetteColor",
+                      sf::Glsl::Vec4(vignetteSprite.getColor()));
+    shader.setUniform("shadowColor",
+                      sf::Glsl::Vec4(vignetteShadowSpr.getColor()));
+    shader.setUniform("amount", desaturate);
+    return shader;
+}
+
+// Scales the frame up to the window, blurred and desaturated as the UI asks.
+// Whichever pass draws to the window also applies the vignette, see
+// composite.frag.
+void Game::postProcess(DynamicResolution::Targets & frame) {
+    sf::RenderTexture & target = frame.scene;
+    sf::RenderTexture & secondPass = frame.secondPass;
+    sf::RenderTexture & thirdPass = frame.thirdPass;
     const sf::Vector2u windowSize = window.getSize();
-    const sf::Vector2f upscaleVec(windowSize.x / viewPort.x,
-                                  windowSize.y / viewPort.y);
+    const sf::Vector2u frameSize = target.getSize();
+    const sf::Vector2f upscaleVec(float(windowSize.x) / frameSize.x,
+                                  float(windowSize.y) / frameSize.y);
+    // The stash is always full size, so that it doesn't depend on the scale
+    // that the frame was drawn at
+    const sf::Vector2f stashScale(viewPort.x / frameSize.x,
+                                  viewPort.y / frameSize.y);
+    const sf::Vector2f stashUpscaleVec(windowSize.x / viewPort.x,
+                                       windowSize.y / viewPort.y);
     if (UI.blurEnabled() && UI.desaturateEnabled()) {
         if (stashed) {
             sf::Sprite targetSprite(stash.getTexture());
             window.setView(camera.getWindowView());
-            targetSprite.setScale(upscaleVec);
+            targetSprite.setScale(stashUpscaleVec);
             window.draw(targetSprite);
         } else {
             sf::Shader & blurShader =
                 getgResHandlerPtr()->getShader(ResHandler::Shader::blur);
-            sf::Shader & desaturateShader =
-                getgResHandlerPtr()->getShader(ResHandler::Shader::desaturate);
+            sf::Shader & compositeShader =
+                getCompositeShader(false, UI.getDesaturateAmount());
             secondPass.clear(sf::Color::Transparent);
             thirdPass.clear(sf::Color::Transparent);
             const sf::Vector2u textureSize = target.getSize();
-            float blurAmount = UI.getBlurAmount();
+            // In texels, so it shrinks along with the frame
+            float blurAmount = UI.getBlurAmount() / stashScale.x;
             const sf::Glsl::Vec2 vBlur =
                 sf::Glsl::Vec2(0.f, blurAmount / textureSize.y);
             blurShader.setUniform("blur_radius", vBlur);
@@ -130,17 +258,17 @@ void Game::updateGraphics() {
             blurShader.setUniform("blur_radius", hBlur);
             thirdPass.draw(sf::Sprite(secondPass.getTexture()), &blurShader);
             thirdPass.display();
-            desaturateShader.setUniform("amount", UI.getDesaturateAmount());
             sf::Sprite targetSprite(thirdPass.getTexture());
             window.setView(camera.getWindowView());
             targetSprite.setScale(upscaleVec);
-            window.draw(targetSprite, &desaturateShader);
+            window.draw(targetSprite, &compositeShader);
             if (!stashed && (UI.getState() == ui::Backend::State::statsScreen ||
                              UI.getState() == ui::Backend::State::menuScreen) &&
                 !camera.moving()) {
                 stash.clear(sf::Color::Black);
-                stash.draw(sf::Sprite(thirdPass.getTexture()),
-                           &desaturateShader);
+                sf::Sprite stashSprite(thirdPass.getTexture());
+                stashSprite.setScale(stashScale);
+                stash.draw(stashSprite, &compositeShader);
                 stash.display();
                 stashed = true;
             }
@@ -152,14 +280,15 @@ void Game::updateGraphics() {
             }
             sf::Sprite targetSprite(stash.getTexture());
             window.setView(camera.getWindowView());
-            targetSprite.setScale(upscaleVec);
+            targetSprite.setScale(stashUpscaleVec);
             window.draw(targetSprite);
         } else {
             sf::Shader & blurShader =
                 getgResHandlerPtr()->getShader(ResHandler::Shader::blur);
             secondPass.clear(sf::Color::Transparent);
             sf::Vector2u textureSize = target.getSize();
-            float blurAmount = UI.getBlurAmount();
+            // In texels, so it shrinks along with the frame
+            float blurAmount = UI.getBlurAmount() / stashScale.x;
             const sf::Glsl::Vec2 vBlur =
                 sf::Glsl::Vec2(0.f, blurAmount / textureSize.y);
             blurShader.setUniform("blur_radius", vBlur);
@@ -167,47 +296,30 @@ void Game::updateGraphics() {
             secondPass.display();
             const sf::Glsl::Vec2 hBlur =
                 sf::Glsl::Vec2(blurAmount / textureSize.x, 0.f);
-            blurShader.setUniform("blur_radius", hBlur);
+            sf::Shader & compositeShader = getCompositeShader(true, 0.f);
+            compositeShader.setUniform("blur_radius", hBlur);
             sf::Sprite targetSprite(secondPass.getTexture());
             window.setView(camera.getWindowView());
             targetSprite.setScale(upscaleVec);
-            window.draw(targetSprite, &blurShader);
+            window.draw(targetSprite, &compositeShader);
             if (!stashed && (UI.getState() == ui::Backend::State::statsScreen ||
                              UI.getState() == ui::Backend::State::menuScreen) &&
                 !camera.moving()) {
                 stash.clear(sf::Color::Black);
-                stash.draw(sf::Sprite(secondPass.getTexture()), &blurShader);
+                sf::Sprite stashSprite(secondPass.getTexture());
+                stashSprite.setScale(stashScale);
+                stash.draw(stashSprite, &compositeShader);
                 stash.display();
                 stashed = true;
                 preload = false;
             }
         }
-    } else if (!UI.blurEnabled() && UI.desaturateEnabled()) {
-        sf::Shader & desaturateShader =
-            getgResHandlerPtr()->getShader(ResHandler::Shader::desaturate);
-        desaturateShader.setUniform("amount", UI.getDesaturateAmount());
-        sf::Sprite targetSprite(target.getTexture());
-        window.setView(camera.getWindowView());
-        targetSprite.setScale(upscaleVec);
-        window.draw(targetSprite, &desaturateShader);
     } else {
+        sf::Shader & compositeShader = getCompositeShader(
+            false, UI.desaturateEnabled() ? UI.getDesaturateAmount() : 0.f);
         sf::Sprite targetSprite(target.getTexture());
         window.setView(camera.getWindowView());
         targetSprite.setScale(upscaleVec);
-        window.draw(targetSprite);
-    }
-    {
-        std::lock_guard<std::mutex> UILock(UIMutex);
-        if (player.getState() == Player::State::dead) {
-            UI.draw(window, uiFrontend);
-        } else {
-            if (transitionState == TransitionState::None) {
-                UI.draw(window, uiFrontend);
-            }
-            uiFrontend.draw(window);
-        }
+        window.draw(targetSprite, &compositeShader);
     }
-    window.setView(worldView);
-    drawTransitions(window);
-    window.display();
 }
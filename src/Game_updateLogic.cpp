@@ -1,25 +1,27 @@
 #include "Game.hpp"
+#include "profiler.hpp"
 
-void Game::updateLogic(const sf::Time & elapsedTime) {
-    if (!hasFocus) {
-	util::sleep(milliseconds(200));
-	return;
-    }
+void Game::updateLogic(const sf::Time & realTime) {
+    // During a hit stop the world freezes, but the logic thread keeps ticking
+    const sf::Time elapsedTime = hitStop.apply(realTime);
     // Blurring is graphics intensive, the game caches frames in a RenderTexture
     // when possible
     if (stashed && UI.getState() != ui::Backend::State::statsScreen &&
         UI.getState() != ui::Backend::State::menuScreen) {
         stashed = false;
     }
-    if (!stashed || preload) {
+    if (!stashed || preload || replayMode) {
         std::lock_guard<std::mutex> overworldLock(overworldMutex);
-        if (level != 0) {
-            const sf::Vector2f & cameraOffset = camera.getOffsetFromStart();
-            bkg.setOffset(cameraOffset.x, cameraOffset.y);
-        } else { // TODO: why is this necessary...?
-            bkg.setOffset(0, 0);
+        {
+            profiler::Scope scope(profiler::Stage::logicTiles);
+            if (level != 0) {
+                const sf::Vector2f & cameraOffset = camera.getOffsetFromStart();
+                bkg.setOffset(cameraOffset.x, cameraOffset.y);
+            } else { // TODO: why is this necessary...?
+                bkg.setOffset(0, 0);
+            }
+            tiles.update();
         }
-        tiles.update();
         auto objUpdatePolicy = [&elapsedTime, this](auto & vec) {
             for (auto it = vec.begin(); it != vec.end();) {
                 if ((*it)->getKillFlag()) {
@@ -30,22 +32,37 @@ void Game::updateLogic(const sf::Time & elapsedTime) {
                 }
             }
         };
-        detailGroup.apply(objUpdatePolicy);
-        helperGroup.apply(objUpdatePolicy);
+        {
+            profiler::Scope scope(profiler::Stage::logicDetails);
+            detailGroup.apply(objUpdatePolicy);
+            helperGroup.apply(objUpdatePolicy);
+        }
         std::vector<sf::Vector2f> cameraTargets;
-        en.update(this, !UI.isOpen(), elapsedTime, cameraTargets);
-        camera.update(elapsedTime, cameraTargets);
+        {
+            profiler::Scope scope(profiler::Stage::logicEnemies);
+            en.update(this, !UI.isOpen(), elapsedTime, cameraTargets);
+        }
+        {
+            profiler::Scope scope(profiler::Stage::logicCamera);
+            camera.update(elapsedTime, cameraTargets);
+        }
         if (player.visible) {
+            profiler::Scope scope(profiler::Stage::logicPlayer);
             player.update(this, elapsedTime, sounds);
             const sf::Vector2f playerPos = player.getPosition();
             sf::Listener::setPosition(playerPos.x, playerPos.y, 35.f);
         }
         if (!UI.isOpen()) {
+            profiler::Scope scope(profiler::Stage::logicEffects);
             effectGroup.apply(objUpdatePolicy);
+            particles.update(elapsedTime);
         }
+        profiler::Scope scope(profiler::Stage::logicVisibility);
+        updateVisibility();
     }
     {
         std::lock_guard<std::mutex> UILock(UIMutex);
+        profiler::Scope scope(profiler::Stage::logicUI);
         if (player.getState() == Player::State::dead) {
             UI.dispDeathSeq();
             if (UI.isComplete()) {
@@ -71,3 +88,16 @@ void Game::updateLogic(const sf::Time & elapsedTime) {
     }
     updateTransitions(elapsedTime);
 }
+
+void Game::updateVisibility() {
+    visibility.begin();
+    auto insertPolicy = [this](auto & vec) { visibility.insertAll(vec); };
+    detailGroup.apply(insertPolicy);
+    effectGroup.apply(insertPolicy);
+    helperGroup.apply(insertPolicy);
+    visibility.insertAll(en.getTurrets().getAnchors());
+    visibility.insertAll(en.getDashers());
+    visibility.insertAll(en.getCritters());
+    visibility.insertAll(en.getScoots().getAnchors());
+    visibility.build(camera.getOverworldView());
+}
@@ -4,11 +4,14 @@
 #include <tuple>
 
 #include "RenderType.hpp"
+#include "spriteBatch.hpp"
 
 using drawContext = std::tuple<sf::Sprite, float, Rendertype, float>;
 
 struct GfxContext {
     std::vector<drawContext> faces, shadows;
     std::vector<sf::Sprite> glowSprs1, glowSprs2;
+    // Motion trails, drawn shaded into the lighting map under the faces
+    SpriteBatch trails{64};
     sf::RenderTexture * targetRef;
 };
@@ -16,10 +16,10 @@ public:
     enum class State { idle, returnToPlayer, approachEnemy };
     using HBox = HitBox<32, 32, 0, -6>;
     _Laika(const float _xInit, const float _yInit, const sf::Texture & texture,
-           Tile _map[MAP_WIDTH][MAP_HEIGHT])
+           const TileMask & _tileMask)
         : Object(_xInit, _yInit), state(State::idle), idleSheet(texture),
           runSheet(texture), shadow(texture), frameIndex(0), animationTimer(0),
-          currentDir(0.f), recalc(0), map(_map) {
+          currentDir(0.f), recalc(0), tileMask(&_tileMask) {
         idleSheet.setPosition(this->getPosition());
         idleSheet.setOrigin(16, 16);
         runSheet.setOrigin(18, 20);
@@ -76,17 +76,16 @@ public:
             } else {
                 auto & enemies = pGame->getEnemyController();
                 std::vector<std::shared_ptr<Object>> enemyVec;
-                const sf::View & cv = pGame->getCamera().getOverworldView();
-                const auto collect = [&cv, &enemyVec](auto & vec) {
+                const auto collect = [&enemyVec](auto & vec) {
                     for (auto & element : vec) {
-                        if (isWithinView(*element, cv)) {
+                        if (element->isVisible()) {
                             enemyVec.push_back(element);
                         }
                     }
                 };
                 collect(enemies.getCritters());
-                collect(enemies.getScoots());
-                collect(enemies.getTurrets());
+                collect(enemies.getScoots().getAnchors());
+                collect(enemies.getTurrets().getAnchors());
                 collect(enemies.getDashers());
                 if (!enemyVec.empty()) {
                     std::sort(enemyVec.begin(), enemyVec.end(),
@@ -190,8 +189,8 @@ public:
             origin.y = (position.y - tiles.posY) / 26;
             target.x = (tiles.posX - destination.x - 12) / -32;
             target.y = (tiles.posY - destination.y - 32) / -26;
-            if (isTileWalkable(map[target.x][target.y])) {
-                path = astar_path(target, origin, map);
+            if (tileMask->isWalkable(target.x, target.y)) {
+                path = astar_path(target, origin, *tileMask);
                 path.pop_back();
                 position.x = ((position.x - tiles.posX) / 32) * 32 + tiles.posX;
                 position.y = ((position.y - tiles.posY) / 26) * 26 + tiles.posY;
@@ -225,7 +224,7 @@ private:
     sf::Sprite shadow;
     uint8_t frameIndex;
     int64_t animationTimer;
-    Tile (*map)[61];
+    const TileMask * tileMask;
     std::vector<aStrCoordinate> path;
     float currentDir;
     int recalc;
@@ -1,6 +1,8 @@
 #pragma once
 
-enum class Tile {
+#include <stdint.h>
+
+enum class Tile : uint8_t {
     Empty,
     Wall,
     PlateLowerEdge,
@@ -15,4 +17,4 @@ enum class Tile {
     GrassFlowers,
     _UNUSED2_,
     Grate
-};
\ No newline at end of file
+};
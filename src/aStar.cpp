@@ -4,7 +4,6 @@
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
-#include "mappingFunctions.hpp"
 
 // Calculates a heuristic based on the distance between two nodes
 inline float heuristic(int x1, int x2, int y1, int y2) {
@@ -38,11 +37,11 @@ struct compare {
 // A function to return a list of adjacent empty squares
 std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
                                         aStrCoordinate & target,
-                                        Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+                                        const TileMask & mask) {
     // Declare a vector of adjacent coordinates to return
     std::vector<aStrCoordinate> adjacentTiles;
     bool diagonalMove = true;
-    if (isTileWalkable(map[coord.x - 1][coord.y])) {
+    if (mask.isWalkable(coord.x - 1, coord.y)) {
         aStrCoordinate newCoord;
         newCoord.g = coord.g + 1;
         newCoord.x = coord.x - 1;
@@ -53,7 +52,7 @@ std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
     } else {
         diagonalMove = false;
     }
-    if (isTileWalkable(map[coord.x + 1][coord.y])) {
+    if (mask.isWalkable(coord.x + 1, coord.y)) {
         aStrCoordinate newCoord;
         newCoord.g = coord.g + 1;
         newCoord.x = coord.x + 1;
@@ -64,7 +63,7 @@ std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
     } else {
         diagonalMove = false;
     }
-    if (isTileWalkable(map[coord.x][coord.y - 1])) {
+    if (mask.isWalkable(coord.x, coord.y - 1)) {
         aStrCoordinate newCoord;
         newCoord.g = coord.g + 1;
         newCoord.x = coord.x;
@@ -75,7 +74,7 @@ std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
     } else {
         diagonalMove = false;
     }
-    if (isTileWalkable(map[coord.x][coord.y + 1])) {
+    if (mask.isWalkable(coord.x, coord.y + 1)) {
         aStrCoordinate newCoord;
         newCoord.g = coord.g + 1;
         newCoord.x = coord.x;
@@ -87,7 +86,7 @@ std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
         diagonalMove = false;
     }
     if (diagonalMove) {
-        if (isTileWalkable(map[coord.x + 1][coord.y + 1])) {
+        if (mask.isWalkable(coord.x + 1, coord.y + 1)) {
             aStrCoordinate newCoord;
             newCoord.g = coord.g + 0.75;
             newCoord.x = coord.x + 1;
@@ -96,7 +95,7 @@ std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
                          heuristic(newCoord.x, target.x, newCoord.y, target.y);
             adjacentTiles.push_back(newCoord);
         }
-        if (isTileWalkable(map[coord.x - 1][coord.y + 1])) {
+        if (mask.isWalkable(coord.x - 1, coord.y + 1)) {
             aStrCoordinate newCoord;
             newCoord.g = coord.g + 0.75;
             newCoord.x = coord.x - 1;
@@ -105,7 +104,7 @@ std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
                          heuristic(newCoord.x, target.x, newCoord.y, target.y);
             adjacentTiles.push_back(newCoord);
         }
-        if (isTileWalkable(map[coord.x - 1][coord.y - 1])) {
+        if (mask.isWalkable(coord.x - 1, coord.y - 1)) {
             aStrCoordinate newCoord;
             newCoord.g = coord.g + 0.75;
             newCoord.x = coord.x - 1;
@@ -114,7 +113,7 @@ std::vector<aStrCoordinate> getAdjacent(aStrCoordinate & coord,
                          heuristic(newCoord.x, target.x, newCoord.y, target.y);
             adjacentTiles.push_back(newCoord);
         }
-        if (isTileWalkable(map[coord.x + 1][coord.y + 1])) {
+        if (mask.isWalkable(coord.x + 1, coord.y + 1)) {
             aStrCoordinate newCoord;
             newCoord.g = coord.g + 0.75;
             newCoord.x = coord.x + 1;
@@ -152,9 +151,12 @@ std::vector<aStrCoordinate> reconstruct_path(
 
 std::vector<aStrCoordinate> astar_path(aStrCoordinate & origin,
                                        aStrCoordinate & target,
-                                       Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+                                       const TileMask & mask) {
     std::vector<aStrCoordinate> closed;
     std::vector<aStrCoordinate> open = {origin};
+    // Membership of both lists is kept in hash sets too, so that the cost of
+    // a search depends on how many tiles it visits, not on their square
+    std::unordered_set<aStrCoordinate> inClosed, inOpen = {origin};
     origin.g = 0;
     origin.f = heuristic(origin.x, target.x, origin.y, target.y);
     std::make_heap(open.begin(), open.end(), compare());
@@ -163,20 +165,21 @@ std::vector<aStrCoordinate> astar_path(aStrCoordinate & origin,
     do {
         aStrCoordinate currentNode = open.back();
         closed.push_back(currentNode);
+        inClosed.insert(currentNode);
         open.pop_back();
-        for (auto element : closed) {
-            if (element.x == target.x && element.y == target.y) {
-                return reconstruct_path(origin, target, cameFrom);
-            }
+        inOpen.erase(currentNode);
+        if (currentNode == target) {
+            return reconstruct_path(origin, target, cameFrom);
         }
         std::vector<aStrCoordinate> adjacentTiles =
-            getAdjacent(currentNode, target, map);
+            getAdjacent(currentNode, target, mask);
         for (auto & element : adjacentTiles) {
-            if (contains(closed, element)) {
+            if (inClosed.count(element)) {
                 continue;
             }
-            if (!contains(open, element)) {
+            if (!inOpen.count(element)) {
                 open.push_back(element);
+                inOpen.insert(element);
                 cameFrom[element] = closed.back();
                 std::push_heap(open.begin(), open.end(), compare());
             }
@@ -2,10 +2,7 @@
 
 #include <stdint.h>
 #include <vector>
-#include "Tile.hpp"
-
-#define MAP_WIDTH 61
-#define MAP_HEIGHT 61
+#include "tileMask.hpp"
 
 // A simple structure to hold ordered pairs
 struct aStrCoordinate {
@@ -15,11 +12,11 @@ struct aStrCoordinate {
 
 // Define a class for a node
 std::vector<aStrCoordinate> astar_path(aStrCoordinate &, aStrCoordinate &,
-                                       Tile map[MAP_WIDTH][MAP_HEIGHT]);
+                                       const TileMask &);
 
 bool contains(std::vector<aStrCoordinate> &, aStrCoordinate &);
 
 std::vector<aStrCoordinate> getAdjacent(aStrCoordinate &, aStrCoordinate &,
-                                        Tile map[MAP_WIDTH][MAP_HEIGHT]);
+                                        const TileMask &);
 
 float heuristic(int, int, int, int);
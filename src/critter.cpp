@@ -4,10 +4,10 @@
 #include "tileController.hpp"
 #include <cmath>
 
-Critter::Critter(const sf::Texture & txtr, Tile _map[61][61], float _xInit,
-                 float _yInit)
+Critter::Critter(const sf::Texture & txtr, const TileMask & _tileMask,
+                 float _xInit, float _yInit)
     : Enemy(_xInit, _yInit), xInit(_xInit), yInit(_yInit), currentDir(0.f),
-      spriteSheet(txtr), awake(false), active(true), recalc(4), map(_map) {
+      spriteSheet(txtr), awake(false), active(true), recalc(4), tileMask(&_tileMask) {
     health = 3;
     spriteSheet.setOrigin(9, 9);
     shadow.setOrigin(9, 9);
@@ -45,7 +45,7 @@ void Critter::update(Game * pGame, const sf::Time & elapsedTime,
         }
     }
     if (health == 0) {
-        unsigned long int temp = rng::random<5>();
+        unsigned long int temp = rng::random<5>(rng::Stream::ai);
         if (temp == 0) {
             effects.add<EffectRef::Heart>(
                 getgResHandlerPtr()->getTexture(
@@ -59,14 +59,10 @@ void Critter::update(Game * pGame, const sf::Time & elapsedTime,
                 getgResHandlerPtr()->getTexture(ResHandler::Texture::blueglow),
                 xInit + 10, yInit, Item::Type::Coin);
         }
-        effects.add<EffectRef::SmallExplosion>(
-            getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-            getgResHandlerPtr()->getTexture(
-                ResHandler::Texture::fireExplosionGlow),
-            xInit + 8, yInit);
+        pGame->getParticles().spawn(ParticleSystem::Kind::SmallExplosion,
+                                    xInit + 8, yInit);
         pGame->getSounds().play(ResHandler::Sound::blast1,
-                                effects.get<EffectRef::SmallExplosion>().back(),
-                                300, 4.f);
+                                sf::Vector2f(xInit + 8, yInit), 300, 4.f);
         killFlag = true;
     }
     position.x -=
@@ -92,8 +88,8 @@ void Critter::update(Game * pGame, const sf::Time & elapsedTime,
             origin.y = (position.y - tilePosY) / 26;
             target.x = (tilePosX - player.getXpos() - 12) / -32;
             target.y = (tilePosY - player.getYpos() - 32) / -26;
-            if (isTileWalkable(map[target.x][target.y])) {
-                path = astar_path(target, origin, map);
+            if (tileMask->isWalkable(target.x, target.y)) {
+                path = astar_path(target, origin, *tileMask);
                 previous = path.back();
                 path.pop_back();
                 xInit = ((position.x - tilePosX) / 32) * 32 + tilePosX;
@@ -4,7 +4,7 @@
 #include "effectsController.hpp"
 #include "enemy.hpp"
 #include "spriteSheet.hpp"
-#include "mappingFunctions.hpp"
+#include "tileMask.hpp"
 
 class tileController;
 
@@ -13,7 +13,7 @@ class Game;
 class Critter : public Enemy {
 public:
     using HBox = HitBox<12, 12, 4, -3>;
-    Critter(const sf::Texture &, Tile map[61][61], float, float);
+    Critter(const sf::Texture &, const TileMask &, float, float);
     void update(Game *, const sf::Time &, tileController & tiles);
     const sf::Sprite & getSprite() const;
     const sf::Sprite & getShadow() const;
@@ -34,6 +34,5 @@ private:
     bool awake;
     bool active;
     int recalc;
-    Tile (*map)[61]; //*** I know this is a nasty solution, perhaps there's a
-                        // better way to not store it locally...
+    const TileMask * tileMask;
 };
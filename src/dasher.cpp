@@ -3,45 +3,12 @@
 #include "angleFunction.hpp"
 #include <cmath>
 
-Dasher::Blur::Blur(sf::Sprite * spr, float xInit, float yInit) {
-    this->spr = *spr;
-    this->xInit = xInit;
-    this->yInit = yInit;
-    killflag = false;
-    timer = 0;
-    sf::Color c = this->spr.getColor();
-    c.a -= 120;
-    c.r -= 30;
-    c.g -= 30;
-    c.b -= 10;
-    this->spr.setColor(c);
-    this->spr.setPosition(xInit, yInit);
-}
-
-sf::Sprite * Dasher::Blur::getSprite() { return &spr; }
-
-void Dasher::Blur::update(const sf::Time & elapsedTime) {
-    timer += elapsedTime.asMilliseconds();
-    if (timer > 18) {
-        timer = 0;
-        sf::Color c = spr.getColor();
-        if (c.a > 30) {
-            c.a -= 30;
-            spr.setColor(c);
-        } else {
-            killflag = true;
-        }
-    }
-}
-
-bool Dasher::Blur::getKillFlag() { return killflag; }
-
 const Dasher::HBox & Dasher::getHitBox() const { return hitBox; }
 
 Dasher::Dasher(const sf::Texture & mainTxtr, float _xPos, float _yPos)
     : Enemy(_xPos, _yPos), shotCount(0), state(State::idle),
-      dasherSheet(mainTxtr), hSpeed(0.f), vSpeed(0.f),
-      timer(0) {
+      dasherSheet(mainTxtr), hSpeed(0.f), vSpeed(0.f), timer(0),
+      trail(dasherSheet.getFrameRect(0), {14.f, 8.f}) {
     dasherSheet.setOrigin(14, 8);
     shadow.setTexture(mainTxtr);
     shadow.setTextureRect(sf::IntRect(0, 100, 18, 16));
@@ -55,8 +22,8 @@ const sf::Sprite & Dasher::getSprite() const {
 
 const sf::Sprite & Dasher::getShadow() const { return shadow; }
 
-void Dasher::update(Game * pGame, const std::vector<wall> & walls,
-                    const sf::Time & elapsedTime) {
+void Dasher::update(Game * pGame, const tileController & tiles,
+                    const sf::Time & elapsedTime, bool coarse) {
     auto & effects = pGame->getEffects();
     auto & details = pGame->getDetails();
     auto & player = pGame->getPlayer();
@@ -87,7 +54,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
 	    details.add<DetailRef::DasherCorpse>(this->getPosition(),
 						 getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
 						 dasherSheet.getScale().x);
-	    unsigned long int temp = rng::random<4>();
+	    unsigned long int temp = rng::random<4>(rng::Stream::ai);
 	    if (temp < 1) {
 		effects.add<EffectRef::Heart>(
 					      getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
@@ -104,11 +71,9 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
 					     getgResHandlerPtr()->getTexture(ResHandler::Texture::blueglow),
 					     position.x, position.y + 4, Item::Type::Coin);
 	    }
-	    effects.add<EffectRef::SmallExplosion>(
-						   getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-						   getgResHandlerPtr()->getTexture(ResHandler::Texture::fireExplosionGlow),
-						   position.x, position.y - 2);
-	    blurEffects.clear();
+	    pGame->getParticles().spawn(ParticleSystem::Kind::SmallExplosion,
+                                        position.x, position.y - 2);
+	    trail.clear();
         }
     }
     SoundController & sounds = pGame->getSounds();
@@ -128,7 +93,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
     case State::idle:
         if (timer >= 200) {
             timer -= 200;
-            const int select = rng::random<2>();
+            const int select = rng::random<2>(rng::Stream::ai);
             if (select) {
                 state = State::dashBegin;
                 frameIndex = 1;
@@ -153,28 +118,10 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
         if (frameTimer > 80 && shotCount < 3) {
             frameTimer -= 80;
             shotCount++;
-            if (position.x > player.getXpos()) {
-                effects.add<EffectRef::TurretFlashEffect>(
-                    getgResHandlerPtr()->getTexture(
-                        ResHandler::Texture::gameObjects),
-                    position.x - 14, position.y + 2);
-                effects.add<EffectRef::DasherShot>(
-                    position.x - 12, position.y,
-                    angleFunction(target.x + 8, target.y + 8, position.x,
-                                  position.y));
-                pGame->getSounds().play(ResHandler::Sound::silenced,
-                                        this->shared_from_this(), 220.f, 5.f);
-            } else {
-                effects.add<EffectRef::TurretFlashEffect>(
-                    getgResHandlerPtr()->getTexture(
-                        ResHandler::Texture::gameObjects),
-                    position.x + 6, position.y + 2);
-                effects.add<EffectRef::DasherShot>(
-                    position.x + 4, position.y,
-                    angleFunction(target.x, target.y + 8, position.x,
-                                  position.y));
-                pGame->getSounds().play(ResHandler::Sound::silenced,
-                                        this->shared_from_this(), 220.f, 5.f);
+            // A coarse dasher counts the shot without firing it, so the
+            // volley lasts as long
+            if (!coarse) {
+                fire(pGame);
             }
         }
         if (timer > 300) {
@@ -205,7 +152,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
                         220.f, 5.f);
             frameIndex = 2;
             uint8_t tries{0};
-            float dir{static_cast<float>(rng::random<359>())};
+            float dir{static_cast<float>(rng::random<359>(rng::Stream::ai))};
             do {
                 tries++;
                 if (tries > 254) {
@@ -214,7 +161,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
                     goto begin;
                 }
                 dir += 12;
-            } while (wallInPath(walls, dir, position.x, position.y));
+            } while (wallInPath(tiles, dir, position.x, position.y));
             hSpeed = 5 * cos(dir);
             vSpeed = 5 * sin(dir);
             if (hSpeed > 0) {
@@ -230,8 +177,8 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
         frameTimer += elapsedTime.asMilliseconds();
         if (frameTimer > 40) {
             frameTimer = 0;
-            blurEffects.emplace_back(dasherSheet.getSpritePtr(), position.x,
-                                     position.y);
+            trail.push(position.x, position.y, frameIndex,
+                       dasherSheet.getScale().x < 0.f);
         }
         if (timer > 250) {
             timer -= 250;
@@ -241,7 +188,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
             vSpeed = 0.f;
         }
 
-        if (Enemy::checkWallCollision(walls, position.x, position.y)) {
+        if (Enemy::checkWallCollision(tiles, position.x, position.y)) {
             hSpeed *= -1.f;
             vSpeed *= -1.f;
         }
@@ -249,7 +196,7 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
 
     case State::dashEnd:
         if (timer > 150) {
-            blurEffects.clear();
+            trail.clear();
             timer -= 150;
             state = State::idle;
             frameIndex = 0;
@@ -257,21 +204,31 @@ void Dasher::update(Game * pGame, const std::vector<wall> & walls,
         break;
     }
 
-    if (!blurEffects.empty()) {
-        for (auto it = blurEffects.begin(); it != blurEffects.end();) {
-            if (it->getKillFlag())
-                it = blurEffects.erase(it);
-            else {
-                it->update(elapsedTime);
-                ++it;
-            }
-        }
-    }
+    trail.update(elapsedTime);
 
     position.x += hSpeed * (elapsedTime.asMicroseconds() * 0.00005f);
     position.y += vSpeed * (elapsedTime.asMicroseconds() * 0.00005f);
 }
 
+void Dasher::fire(Game * pGame) {
+    auto & effects = pGame->getEffects();
+    if (position.x > pGame->getPlayer().getXpos()) {
+        pGame->getParticles().spawn(ParticleSystem::Kind::TurretFlash,
+                                    position.x - 14, position.y + 2);
+        effects.add<EffectRef::DasherShot>(
+            position.x - 12, position.y,
+            angleFunction(target.x + 8, target.y + 8, position.x, position.y));
+    } else {
+        pGame->getParticles().spawn(ParticleSystem::Kind::TurretFlash,
+                                    position.x + 6, position.y + 2);
+        effects.add<EffectRef::DasherShot>(
+            position.x + 4, position.y,
+            angleFunction(target.x, target.y + 8, position.x, position.y));
+    }
+    pGame->getSounds().play(ResHandler::Sound::silenced,
+                            this->shared_from_this(), 220.f, 5.f);
+}
+
 Dasher::State Dasher::getState() const { return state; }
 
-std::vector<Dasher::Blur> * Dasher::getBlurEffects() { return &blurEffects; }
+const MotionTrail & Dasher::getTrail() const { return trail; }
@@ -2,6 +2,7 @@
 
 #include "effectsController.hpp"
 #include "enemy.hpp"
+#include "motionTrail.hpp"
 #include "resourceHandler.hpp"
 #include "soundController.hpp"
 
@@ -10,17 +11,6 @@ class Game;
 class Dasher : public Enemy, public std::enable_shared_from_this<Dasher> {
 public:
     using HBox = HitBox<20, 32, -6, -4>;
-    struct Blur {
-        Blur(sf::Sprite *, float, float);
-        sf::Sprite * getSprite();
-        void update(const sf::Time &);
-        bool getKillFlag();
-        int32_t timer;
-        float xInit;
-        float yInit;
-        sf::Sprite spr;
-        bool killflag;
-    };
     enum class State {
         idle,
         shooting,
@@ -33,8 +23,10 @@ public:
     Dasher(const sf::Texture &, float, float);
     const sf::Sprite & getSprite() const;
     const sf::Sprite & getShadow() const;
-    void update(Game * pGame, const std::vector<wall> &, const sf::Time &);
-    std::vector<Dasher::Blur> * getBlurEffects();
+    // A coarse update keeps the dasher moving, but it holds its fire
+    void update(Game * pGame, const tileController &, const sf::Time &,
+                bool coarse);
+    const MotionTrail & getTrail() const;
     State getState() const;
     const sf::Vector2f & getScale() const;
     const HBox & getHitBox() const;
@@ -48,6 +40,7 @@ private:
     sf::Vector2f target;
     float hSpeed, vSpeed;
     int32_t timer;
-    std::vector<Dasher::Blur> blurEffects;
+    MotionTrail trail;
     void facePlayer();
+    void fire(Game *);
 };
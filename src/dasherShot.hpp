@@ -27,11 +27,12 @@ public:
         spriteSheet.setOrigin(6, 6);
         glowSprite.setTexture(res->getTexture(ResHandler::Texture::redglow));
         glowSprite.setOrigin(22.5, 22.5);
-        int diff = pow(-1, rng::random<2>() + rng::random<6, -3>());
+        int diff = pow(-1, rng::random<2>(rng::Stream::fx) +
+                               rng::random<6, -3>(rng::Stream::fx));
         direction = (dir + diff) * (3.14 / 180);
-        initialVelocity = 5.8f + (0.8f * rng::random<3>());
+        initialVelocity = 5.8f + (0.8f * rng::random<3>(rng::Stream::fx));
         timeout = 0;
-        driftSel = rng::random<2>();
+        driftSel = rng::random<2>(rng::Stream::fx);
     }
     void initSounds(SoundController & sounds) {
         sounds.play(ResHandler::Sound::espark, this->shared_from_this(), 38.f,
@@ -0,0 +1,115 @@
+#include "dynamicResolution.hpp"
+#include <algorithm>
+#include <cmath>
+
+static const float stepSize = 0.125f;
+// Frames are measured in windows of this many, and a window that runs over
+// budget by a fifth drops the scale a step. It takes four windows in a row
+// drawing in under half the budget to raise it again.
+static const int windowLength = 30;
+static const int headroomWindowsToRaise = 4;
+// Frames left out of the measurements after a change of scale, while the
+// new textures warm up
+static const int settleLength = 30;
+
+DynamicResolution::DynamicResolution(nlohmann::json & config,
+                                     const sf::Vector2f & viewPort)
+    : viewPort(viewPort), enabled(false), budget(1000000 / 60),
+      stepCount(1), step(0), drawTime(0), windowDraw(0), windowFrame(0),
+      windowFrames(0), settleFrames(0), headroomWindows(0) {
+    float minScale = 1.f;
+    auto graphics = config.find("Graphics");
+    if (graphics != config.end()) {
+        enabled = graphics->value("DynamicResolution", false);
+        minScale = graphics->value("MinimumScale", 0.5f);
+        const int framerate = graphics->value("TargetFramerate", 60);
+        if (framerate > 0) {
+            budget = microseconds(1000000 / framerate);
+        }
+    }
+    minScale = std::max(0.25f, std::min(minScale, 1.f));
+    stepCount = 1 + static_cast<size_t>((1.f - minScale) / stepSize + 0.001f);
+    pool.resize(stepCount);
+}
+
+DynamicResolution::Targets & DynamicResolution::beginFrame() {
+    frameStart = high_resolution_clock::now();
+    return getTargets(step);
+}
+
+void DynamicResolution::endFrame() {
+    drawTime = std::chrono::duration_cast<microseconds>(
+        high_resolution_clock::now() - frameStart);
+}
+
+void DynamicResolution::framePresented() {
+    const time_point now = high_resolution_clock::now();
+    const auto frameTime =
+        std::chrono::duration_cast<microseconds>(now - lastPresent);
+    const bool first = lastPresent == time_point();
+    lastPresent = now;
+    if (!enabled || first) {
+        return;
+    }
+    if (settleFrames > 0) {
+        --settleFrames;
+        return;
+    }
+    // So that one long hitch, e.g. a level swap, can't decide a window alone
+    windowFrame += std::min(frameTime, budget * 2);
+    windowDraw += std::min(drawTime, budget * 2);
+    if (++windowFrames == windowLength) {
+        adjust();
+        windowFrames = 0;
+        windowFrame = microseconds(0);
+        windowDraw = microseconds(0);
+    }
+}
+
+void DynamicResolution::adjust() {
+    const auto meanFrame = windowFrame / windowFrames;
+    const auto meanDraw = windowDraw / windowFrames;
+    if (meanFrame * 5 > budget * 6) {
+        headroomWindows = 0;
+        if (step + 1 < stepCount) {
+            ++step;
+            settleFrames = settleLength;
+        }
+    } else if (meanDraw * 2 < budget && meanFrame * 10 < budget * 11) {
+        if (++headroomWindows >= headroomWindowsToRaise && step > 0) {
+            --step;
+            settleFrames = settleLength;
+            headroomWindows = 0;
+        }
+    } else {
+        headroomWindows = 0;
+    }
+}
+
+void DynamicResolution::setEnabled(bool enabled) {
+    this->enabled = enabled;
+    if (!enabled) {
+        step = 0;
+    }
+}
+
+float DynamicResolution::getScale() const { return 1.f - step * stepSize; }
+
+DynamicResolution::Targets & DynamicResolution::getTargets(size_t step) {
+    if (!pool[step]) {
+        const float scale = 1.f - step * stepSize;
+        const unsigned width = std::lround(viewPort.x * scale);
+        const unsigned height = std::lround(viewPort.y * scale);
+        pool[step] = std::make_unique<Targets>();
+        Targets & targets = *pool[step];
+        targets.scene.create(width, height);
+        // Nearest neighbour only upscales cleanly at full resolution
+        targets.scene.setSmooth(step != 0);
+        targets.lighting.create(width, height);
+        targets.secondPass.create(width, height);
+        targets.secondPass.setSmooth(true);
+        targets.thirdPass.create(width, height);
+        targets.thirdPass.setSmooth(true);
+    }
+    return *pool[step];
+}
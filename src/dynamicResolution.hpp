@@ -0,0 +1,47 @@
+#pragma once
+
+#include "alias.hpp"
+#include <SFML/Graphics.hpp>
+#include <json.hpp>
+#include <memory>
+#include <vector>
+
+// Scales the resolution that the world draws at, to keep frames within the
+// budget set by Graphics.TargetFramerate in the config. The scale moves in
+// fixed steps, each with its own set of render textures. A step's textures
+// are created the first time the step is used and kept after that, so
+// changing scale back and forth never recreates them. Post processing
+// stretches whichever set the frame drew into up to the window.
+//
+// A frame that runs over budget shows up as a long gap between presents,
+// but with vsync on the gap never gets shorter than the refresh interval,
+// so the time spent drawing before display() is what shows there's room to
+// scale back up. Main thread only.
+class DynamicResolution {
+public:
+    struct Targets {
+        sf::RenderTexture scene, lighting, secondPass, thirdPass;
+    };
+    DynamicResolution(nlohmann::json & config, const sf::Vector2f & viewPort);
+    // Returns the textures to draw the frame into, at the current scale
+    Targets & beginFrame();
+    // Call once the frame is drawn, right before display()
+    void endFrame();
+    // Call right after display(), picks the scale for the next frame
+    void framePresented();
+    // When disabled, frames always draw at full resolution
+    void setEnabled(bool enabled);
+    float getScale() const;
+
+private:
+    Targets & getTargets(size_t step);
+    void adjust();
+    sf::Vector2f viewPort;
+    bool enabled;
+    microseconds budget;
+    size_t stepCount, step;
+    std::vector<std::unique_ptr<Targets>> pool;
+    time_point frameStart, lastPresent;
+    microseconds drawTime, windowDraw, windowFrame;
+    int windowFrames, settleFrames, headroomWindows;
+};
@@ -2,7 +2,6 @@
 
 #include <memory>
 
-#include "FireExplosion.hpp"
 #include "Item.hpp"
 #include "RenderType.hpp"
 #include "bulletType1.hpp"
@@ -10,17 +9,10 @@
 #include "enemyShot.hpp"
 #include "framework/framework.hpp"
 #include "resourceHandler.hpp"
-#include "shotPuff.hpp"
-#include "smallExplosion.hpp"
-#include "turretFlashEffect.hpp"
 #include "turretShot.hpp"
 #include <SFML/Graphics.hpp>
 
 using DefaultEffectPolicy = RenderPolicy<DrawMainRaw, DrawGlowFloor>;
-using TurretFlashEffect = _TurretFlashEffect<RenderPolicy<DrawMainRaw>>;
-using SmallExplosion = _SmallExplosion<DefaultEffectPolicy>;
-using FireExplosion = _FireExplosion<DefaultEffectPolicy>;
-using ShotPuff = _ShotPuff<RenderPolicy<DrawMainRaw>>;
 using Item = _Item<DefaultEffectPolicy>;
 using EnemyShot = _EnemyShot<DefaultEffectPolicy>;
 using DasherShot = _DasherShot<DefaultEffectPolicy>;
@@ -29,10 +21,6 @@ using PlayerShot = _PlayerShot<DefaultEffectPolicy>;
 
 struct EffectRef {
     enum {
-        TurretFlashEffect,
-        SmallExplosion,
-        FireExplosion,
-        ShotPuff,
         Heart,
         Coin,
         GoldHeart,
@@ -44,6 +32,6 @@ struct EffectRef {
     };
 };
 
+// Explosions and flashes are particles instead, see particles.hpp
 using EffectGroup =
-    Group<TurretFlashEffect, SmallExplosion, FireExplosion, ShotPuff, Item,
-          Item, Item, EnemyShot, DasherShot, TurretShot, PlayerShot>;
+    Group<Item, Item, Item, EnemyShot, DasherShot, TurretShot, PlayerShot>;
@@ -1,48 +1,50 @@
 #include "enemy.hpp"
+#include "tileController.hpp"
 
 Enemy::Enemy(float _xPos, float _yPos)
     : Object(_xPos, _yPos), colored(false), colorAmount(0.f), frameIndex(0),
-      colorTimer(0), frameTimer(0) {}
+      colorTimer(0), frameTimer(0), simulationBacklog(0) {}
 
 float Enemy::getColorAmount() const { return colorAmount; }
 
+int32_t & Enemy::getSimulationBacklog() { return simulationBacklog; }
+
 bool Enemy::isColored() const { return colored; }
 
-uint_fast8_t Enemy::checkWallCollision(const std::vector<wall> & w, float xPos,
-                                       float yPos) {
+uint_fast8_t Enemy::checkWallCollision(const tileController & tiles,
+                                       float xPos, float yPos) {
     uint_fast8_t collisionMask = 0;
-    for (auto & element : w) {
-        if ((xPos + 6 < (element.getPosX() + element.getWidth()) &&
-             (xPos + 6 > (element.getPosX()))) &&
-            (fabs((yPos + 16) - element.getPosY()) <= 13)) {
+    // Walls outside of this box can't pass any of the tests below
+    const sf::FloatRect area(xPos - 26, yPos - 4, 50, 40);
+    tiles.forEachWallIn(area, [&](const sf::Vector2f & element) {
+        if ((xPos + 6 < (element.x + 32) && (xPos + 6 > (element.x))) &&
+            (fabs((yPos + 16) - element.y) <= 13)) {
             collisionMask |= 0x01;
         }
 
-        if ((xPos + 24 > (element.getPosX()) &&
-             (xPos + 24 < (element.getPosX() + element.getWidth()))) &&
-            (fabs((yPos + 16) - element.getPosY()) <= 13)) {
+        if ((xPos + 24 > (element.x) && (xPos + 24 < (element.x + 32))) &&
+            (fabs((yPos + 16) - element.y) <= 13)) {
             collisionMask |= 0x02;
         }
 
-        if (((yPos + 22 < (element.getPosY() + element.getHeight())) &&
-             (yPos + 22 > (element.getPosY()))) &&
-            (fabs((xPos)-element.getPosX()) <= 16)) {
+        if (((yPos + 22 < (element.y + 26)) && (yPos + 22 > (element.y))) &&
+            (fabs((xPos)-element.x) <= 16)) {
             collisionMask |= 0x04;
         }
 
-        if (((yPos + 36 > element.getPosY()) &&
-             (yPos + 36 < element.getPosY() + element.getHeight())) &&
-            (fabs((xPos)-element.getPosX()) <= 16)) {
+        if (((yPos + 36 > element.y) && (yPos + 36 < element.y + 26)) &&
+            (fabs((xPos)-element.x) <= 16)) {
             collisionMask |= 0x08;
         }
-    }
+    });
     return collisionMask;
 }
 
-bool Enemy::wallInPath(const std::vector<wall> & w, float dir, float xPos,
+bool Enemy::wallInPath(const tileController & tiles, float dir, float xPos,
                        float yPos) {
     for (int i{10}; i < 100; i += 16) {
-        if (checkWallCollision(w, xPos + cos(dir) * i, yPos + sin(dir) * i)) {
+        if (checkWallCollision(tiles, xPos + cos(dir) * i,
+                               yPos + sin(dir) * i)) {
             return true;
         }
     }
@@ -7,20 +7,28 @@
 #include <cmath>
 #include <vector>
 
+class tileController;
+
 class Enemy : public Object {
 protected:
     bool colored;
     float colorAmount;
     uint8_t frameIndex, health;
     uint32_t colorTimer, frameTimer;
-    uint_fast8_t checkWallCollision(const std::vector<wall> &, float, float);
-    bool wallInPath(const std::vector<wall> &, float, float, float);
+    int32_t simulationBacklog;
+    static bool wallInPath(const tileController &, float, float, float);
     void updateColor(const sf::Time &);
     void facePlayer();
     ~Enemy(){};
 
 public:
     Enemy(float, float);
+    // Returns a mask of the sides that are up against a wall
+    static uint_fast8_t checkWallCollision(const tileController &, float,
+                                           float);
     bool isColored() const;
     float getColorAmount() const;
+    // The time the enemy has missed while simulated coarsely, see
+    // SimulationLod
+    int32_t & getSimulationBacklog();
 };
@@ -10,30 +10,12 @@
 enemyController::enemyController() {}
 
 void enemyController::draw(drawableVec & gameObjects, drawableVec & gameShadows,
-                           Camera & camera) {
-    const sf::View & cameraView = camera.getOverworldView();
-    sf::Vector2f viewCenter = cameraView.getCenter();
-    sf::Vector2f viewSize = cameraView.getSize();
-    for (auto & element : turrets) {
-        if (element->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-            element->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-            element->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-            element->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
-            std::tuple<sf::Sprite, float, Rendertype, float> shadow;
-            std::get<0>(shadow) = element->getShadow();
-            gameShadows.push_back(shadow);
-            std::tuple<sf::Sprite, float, Rendertype, float> tSpr;
-            std::get<0>(tSpr) = element->getSprite();
-            std::get<1>(tSpr) = element->getPosition().y;
-            if (element->colored()) {
-                std::get<2>(tSpr) = Rendertype::shadeWhite;
-            } else {
-                std::get<2>(tSpr) = Rendertype::shadeDefault;
-            }
-            gameObjects.push_back(tSpr);
-        }
-    }
+                           SpriteBatch & trails) {
+    turrets.draw(gameObjects, gameShadows);
     for (auto & element : critters) {
+        if (!element->isVisible()) {
+            continue;
+        }
         gameShadows.emplace_back(element->getShadow(), 0.f,
                                  Rendertype::shadeDefault, 0.f);
         std::tuple<sf::Sprite, float, Rendertype, float> tSpr;
@@ -51,36 +33,14 @@ void enemyController::draw(drawableVec & gameObjects, drawableVec & gameShadows,
                                      Rendertype::shadeDefault, 0.f);
         }
     }
-    for (auto & element : scoots) {
-        if (element->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-            element->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-            element->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-            element->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
-            gameShadows.emplace_back(element->getShadow(), 0.f,
-                                     Rendertype::shadeDefault, 0.f);
-            if (element->isColored()) {
-                gameObjects.emplace_back(
-                    element->getSprite(), element->getPosition().y - 16,
-                    Rendertype::shadeWhite, element->getColorAmount());
-            } else {
-                gameObjects.emplace_back(element->getSprite(),
-                                         element->getPosition().y - 16,
-                                         Rendertype::shadeDefault, 0.f);
-            }
-        }
-    }
+    scoots.draw(gameObjects, gameShadows);
     for (auto & element : dashers) {
-        if (element->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-            element->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-            element->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-            element->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
+        if (element->isVisible()) {
             auto state = element->getState();
 	    gameShadows.emplace_back(element->getShadow(), 0.f,
 				     Rendertype::shadeDefault, 0.f);
-            for (auto & blur : *element->getBlurEffects()) {
-                gameObjects.emplace_back(*blur.getSprite(), blur.yInit + 200,
-                                         Rendertype::shadeDefault, 0.f);
-            }
+            element->getTrail().draw(
+                trails, *element->getSprite().getTexture());
             if (element->isColored()) {
                 gameObjects.emplace_back(
                     element->getSprite(), element->getPosition().y,
@@ -94,6 +54,19 @@ void enemyController::draw(drawableVec & gameObjects, drawableVec & gameShadows,
     }
 }
 
+// Calls update with the enemy's step and whether it's coarse, unless the
+// enemy sits this tick out
+template <typename F>
+static void simulate(const SimulationLod & lod, Enemy & enemy, size_t index,
+                     const F & update) {
+    const SimulationLod::Tier tier =
+        SimulationLod::tierOf(enemy.getProximity());
+    const int32_t micros = lod.step(tier, enemy.getSimulationBacklog(), index);
+    if (micros > 0) {
+        update(sf::microseconds(micros), tier == SimulationLod::Tier::coarse);
+    }
+}
+
 void enemyController::update(Game * pGame, bool enabled,
                              const sf::Time & elapsedTime,
                              std::vector<sf::Vector2f> & cameraTargets) {
@@ -101,59 +74,17 @@ void enemyController::update(Game * pGame, bool enabled,
     tileController & tileController = pGame->getTileController();
     Camera & camera = pGame->getCamera();
     Player * player = &pGame->getPlayer();
-    const sf::View & cameraView = camera.getOverworldView();
-    sf::Vector2f viewCenter = cameraView.getCenter();
-    sf::Vector2f viewSize = cameraView.getSize();
-    if (!turrets.empty()) {
-        for (auto it = turrets.begin(); it != turrets.end();) {
-            if ((*it)->getKillFlag() == 1) {
-                util::sleep(milliseconds(60));
-                camera.shake(0.17f);
-                it = turrets.erase(it);
-            } else {
-                if ((*it)->getPosition().x >
-                        viewCenter.x - viewSize.x / 2 - 32 &&
-                    (*it)->getPosition().x <
-                        viewCenter.x + viewSize.x / 2 + 32 &&
-                    (*it)->getPosition().y >
-                        viewCenter.y - viewSize.y / 2 - 32 &&
-                    (*it)->getPosition().y <
-                        viewCenter.y + viewSize.y / 2 + 32) {
-                    if (enabled) {
-                        (*it)->update(elapsedTime, pGame);
-                    }
-                    cameraTargets.emplace_back((*it)->getPosition().x,
-                                               (*it)->getPosition().y);
-                }
-                ++it;
-            }
-        }
-    }
-    if (!scoots.empty()) {
-        for (auto it = scoots.begin(); it != scoots.end();) {
-            if ((*it)->getKillFlag()) {
-                util::sleep(milliseconds(60));
-                camera.shake(0.17f);
-                it = scoots.erase(it);
-            } else {
-                if ((*it)->getPosition().x >
-                        viewCenter.x - viewSize.x / 2 - 32 &&
-                    (*it)->getPosition().x <
-                        viewCenter.x + viewSize.x / 2 + 32 &&
-                    (*it)->getPosition().y >
-                        viewCenter.y - viewSize.y / 2 - 32 &&
-                    (*it)->getPosition().y <
-                        viewCenter.y + viewSize.y / 2 + 32) {
-                    if (enabled) {
-                        (*it)->update(pGame, tileController.walls, elapsedTime);
-                    }
-                    cameraTargets.emplace_back((*it)->getPosition().x,
-                                               (*it)->getPosition().y);
-                }
-                ++it;
-            }
-        }
-    }
+    lod.beginTick(elapsedTime);
+    turrets.removeDead([&] {
+        pGame->getHitStop().start(sf::milliseconds(60));
+        camera.shake(0.17f);
+    });
+    turrets.update(pGame, enabled, lod, cameraTargets);
+    scoots.removeDead([&] {
+        pGame->getHitStop().start(sf::milliseconds(60));
+        camera.shake(0.17f);
+    });
+    scoots.update(pGame, enabled, tileController, lod, cameraTargets);
     if (!critters.empty()) {
         // Need to check if each enemy overlaps with any other enemies so that
         // they don't bunch up
@@ -175,23 +106,19 @@ void enemyController::update(Game * pGame, bool enabled,
         }
         for (auto it = critters.begin(); it != critters.end();) {
             if ((*it)->getKillFlag()) {
-                util::sleep(milliseconds(60));
+                pGame->getHitStop().start(sf::milliseconds(60));
                 camera.shake(0.17f);
                 it = critters.erase(it);
             } else {
-                if ((*it)->getPosition().x >
-                        viewCenter.x - viewSize.x / 2 - 32 &&
-                    (*it)->getPosition().x <
-                        viewCenter.x + viewSize.x / 2 + 32 &&
-                    (*it)->getPosition().y >
-                        viewCenter.y - viewSize.y / 2 - 32 &&
-                    (*it)->getPosition().y <
-                        viewCenter.y + viewSize.y / 2 + 32) {
+                if ((*it)->isOnScreen()) {
                     cameraTargets.emplace_back((*it)->getPosition().x,
                                                (*it)->getPosition().y);
                 }
                 if (enabled) {
-                    (*it)->update(pGame, elapsedTime, tileController);
+                    simulate(lod, **it, it - critters.begin(),
+                             [&](const sf::Time & step, bool) {
+                                 (*it)->update(pGame, step, tileController);
+                             });
                 }
                 ++it;
             }
@@ -206,16 +133,17 @@ void enemyController::update(Game * pGame, bool enabled,
     if (!dashers.empty()) {
 	for (auto it = dashers.begin(); it != dashers.end();) {
 	    if ((*it)->getKillFlag()) {
-		util::sleep(milliseconds(60));
+		pGame->getHitStop().start(sf::milliseconds(60));
 		camera.shake(0.17f);
 		it = dashers.erase(it);
 	    } else {
-		if ((*it)->getPosition().x > viewCenter.x - viewSize.x / 2 - 32 &&
-		    (*it)->getPosition().x < viewCenter.x + viewSize.x / 2 + 32 &&
-		    (*it)->getPosition().y > viewCenter.y - viewSize.y / 2 - 32 &&
-		    (*it)->getPosition().y < viewCenter.y + viewSize.y / 2 + 32) {
-		    if (enabled) {
-			(*it)->update(pGame, tileController.walls, elapsedTime);
+		if (enabled) {
+		    simulate(lod, **it, it - dashers.begin(),
+			     [&](const sf::Time & step, bool coarse) {
+				 (*it)->update(pGame, tileController, step,
+					       coarse);
+			     });
+		    if ((*it)->isOnScreen()) {
 			cameraTargets.emplace_back((*it)->getPosition().x,
 						   (*it)->getPosition().y);
 		    }
@@ -233,56 +161,36 @@ void enemyController::clear() {
     critters.clear();
 }
 
-void enemyController::addTurret(tileController * pTiles) {
-    auto pCoordVec = pTiles->getEmptyLocations();
-    int locationSelect = rng::random<2>() ? rng::random(pCoordVec->size() / 2)
-                                          : rng::random(pCoordVec->size());
-    float xInit = (*pCoordVec)[locationSelect].x * 32 + pTiles->getPosX();
-    float yInit = (*pCoordVec)[locationSelect].y * 26 + pTiles->getPosY();
-    turrets.push_back(std::make_shared<Turret>(
-        getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-        xInit, yInit));
-    (*pCoordVec)[locationSelect] = pCoordVec->back();
-    pCoordVec->pop_back();
+void enemyController::addTurret(tileController * pTiles,
+                                const Coordinate & c) {
+    float xInit = c.x * 32 + pTiles->getPosX();
+    float yInit = c.y * 26 + pTiles->getPosY();
+    turrets.add(xInit, yInit);
 }
 
-void enemyController::addScoot(tileController * pTiles) {
-    auto pCoordVec = pTiles->getEmptyLocations();
-    int locationSelect = rng::random<2>() ? rng::random(pCoordVec->size() / 2)
-                                          : rng::random(pCoordVec->size());
-    float xInit = (*pCoordVec)[locationSelect].x * 32 + pTiles->getPosX();
-    float yInit = (*pCoordVec)[locationSelect].y * 26 + pTiles->getPosY();
-    scoots.push_back(std::make_shared<Scoot>(
-        getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-        getgResHandlerPtr()->getTexture(ResHandler::Texture::scootShadow),
-        xInit, yInit));
-    (*pCoordVec)[locationSelect] = pCoordVec->back();
-    pCoordVec->pop_back();
+void enemyController::addScoot(tileController * pTiles,
+                               const Coordinate & c) {
+    float xInit = c.x * 32 + pTiles->getPosX();
+    float yInit = c.y * 26 + pTiles->getPosY();
+    scoots.add(xInit, yInit);
 }
 
-void enemyController::addDasher(tileController * pTiles) {
-    auto pCoordVec = pTiles->getEmptyLocations();
-    int locationSelect = rng::random<2>() ? rng::random(pCoordVec->size() / 2)
-                                          : rng::random(pCoordVec->size() / 2);
-    float xInit = (*pCoordVec)[locationSelect].x * 32 + pTiles->getPosX();
-    float yInit = (*pCoordVec)[locationSelect].y * 26 + pTiles->getPosY();
+void enemyController::addDasher(tileController * pTiles,
+                                const Coordinate & c) {
+    float xInit = c.x * 32 + pTiles->getPosX();
+    float yInit = c.y * 26 + pTiles->getPosY();
     dashers.push_back(std::make_shared<Dasher>(
         getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
         xInit, yInit));
-    (*pCoordVec)[locationSelect] = pCoordVec->back();
-    pCoordVec->pop_back();
 }
 
-void enemyController::addCritter(tileController * pTiles) {
-    auto pCoordVec = pTiles->getEmptyLocations();
-    int locationSelect = rng::random(pCoordVec->size());
-    float xInit = (*pCoordVec)[locationSelect].x * 32 + pTiles->getPosX();
-    float yInit = (*pCoordVec)[locationSelect].y * 26 + pTiles->getPosY();
+void enemyController::addCritter(tileController * pTiles,
+                                 const Coordinate & c) {
+    float xInit = c.x * 32 + pTiles->getPosX();
+    float yInit = c.y * 26 + pTiles->getPosY();
     critters.push_back(std::make_shared<Critter>(
         getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-        pTiles->mapArray, xInit, yInit));
-    (*pCoordVec)[locationSelect] = pCoordVec->back();
-    pCoordVec->pop_back();
+        pTiles->tileMask, xInit, yInit));
 }
 
 void enemyController::setWindowSize(float windowW, float windowH) {
@@ -298,10 +206,6 @@ std::vector<std::shared_ptr<Dasher>> & enemyController::getDashers() {
     return dashers;
 }
 
-std::vector<std::shared_ptr<Scoot>> & enemyController::getScoots() {
-    return scoots;
-}
+ScootGroup & enemyController::getScoots() { return scoots; }
 
-std::vector<std::shared_ptr<Turret>> & enemyController::getTurrets() {
-    return turrets;
-}
+TurretGroup & enemyController::getTurrets() { return turrets; }
@@ -1,13 +1,16 @@
 #pragma once
 
 #include "RenderType.hpp"
+#include "coordinate.hpp"
 #include "critter.hpp"
 #include "dasher.hpp"
 #include "effectsController.hpp"
 #include "resourceHandler.hpp"
 #include "scoot.hpp"
+#include "simulationLod.hpp"
 #include "turret.hpp"
 #include "util.hpp"
+#include "visibility.hpp"
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <thread>
@@ -22,25 +25,31 @@ class enemyController {
 private:
     using drawableVec =
         std::vector<std::tuple<sf::Sprite, float, Rendertype, float>>;
-    std::vector<std::shared_ptr<Turret>> turrets;
-    std::vector<std::shared_ptr<Scoot>> scoots;
+    // Turrets and scoots keep their state in EnemyKinematics. Dashers and
+    // critters are still objects: a dasher owns a motion trail and is the
+    // source of its own sounds, and critters path find, so moving them over
+    // is left for a follow-up.
+    TurretGroup turrets;
+    ScootGroup scoots;
     std::vector<std::shared_ptr<Dasher>> dashers;
     std::vector<std::shared_ptr<Critter>> critters;
+    SimulationLod lod;
     float windowW;
     float windowH;
 
 public:
     enemyController();
     void update(Game *, bool, const sf::Time &, std::vector<sf::Vector2f> &);
-    void draw(drawableVec &, drawableVec &, Camera &);
+    // Draws the enemies the last VisibilitySet::build() found near the view
+    void draw(drawableVec &, drawableVec &, SpriteBatch & trails);
     void clear();
-    void addTurret(tileController *);
-    void addScoot(tileController *);
-    void addDasher(tileController *);
-    void addCritter(tileController *);
+    void addTurret(tileController *, const Coordinate &);
+    void addScoot(tileController *, const Coordinate &);
+    void addDasher(tileController *, const Coordinate &);
+    void addCritter(tileController *, const Coordinate &);
     void setWindowSize(float, float);
     std::vector<std::shared_ptr<Critter>> & getCritters();
-    std::vector<std::shared_ptr<Scoot>> & getScoots();
+    ScootGroup & getScoots();
     std::vector<std::shared_ptr<Dasher>> & getDashers();
-    std::vector<std::shared_ptr<Turret>> & getTurrets();
+    TurretGroup & getTurrets();
 };
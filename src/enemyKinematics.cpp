@@ -0,0 +1,95 @@
+#include "enemyKinematics.hpp"
+
+ViewBounds::ViewBounds(const sf::View & view, float margin) {
+    const sf::Vector2f center = view.getCenter();
+    const sf::Vector2f size = view.getSize();
+    left = center.x - size.x / 2 - margin;
+    right = center.x + size.x / 2 + margin;
+    top = center.y - size.y / 2 - margin;
+    bottom = center.y + size.y / 2 + margin;
+}
+
+size_t EnemyKinematics::size() const { return x.size(); }
+
+size_t EnemyKinematics::add(float x, float y, float hSpeed, float vSpeed,
+                            uint8_t health) {
+    this->x.push_back(x);
+    this->y.push_back(y);
+    this->hSpeed.push_back(hSpeed);
+    this->vSpeed.push_back(vSpeed);
+    speedScale.push_back(1.f);
+    colorAmount.push_back(0.f);
+    colorTimer.push_back(0);
+    step.push_back(0);
+    backlog.push_back(0);
+    this->health.push_back(health);
+    state.push_back(0);
+    tier.push_back(SimulationLod::Tier::asleep);
+    return this->x.size() - 1;
+}
+
+template <typename T> static void removeAt(std::vector<T> & vec, size_t index) {
+    vec[index] = vec.back();
+    vec.pop_back();
+}
+
+void EnemyKinematics::removeAt(size_t index) {
+    ::removeAt(x, index);
+    ::removeAt(y, index);
+    ::removeAt(hSpeed, index);
+    ::removeAt(vSpeed, index);
+    ::removeAt(speedScale, index);
+    ::removeAt(colorAmount, index);
+    ::removeAt(colorTimer, index);
+    ::removeAt(step, index);
+    ::removeAt(backlog, index);
+    ::removeAt(health, index);
+    ::removeAt(state, index);
+    ::removeAt(tier, index);
+}
+
+void EnemyKinematics::clear() {
+    x.clear();
+    y.clear();
+    hSpeed.clear();
+    vSpeed.clear();
+    speedScale.clear();
+    colorAmount.clear();
+    colorTimer.clear();
+    step.clear();
+    backlog.clear();
+    health.clear();
+    state.clear();
+    tier.clear();
+}
+
+void EnemyKinematics::schedule(const SimulationLod & lod) {
+    const size_t count = size();
+    for (size_t i = 0; i < count; ++i) {
+        step[i] = lod.step(tier[i], backlog[i], i);
+    }
+}
+
+void EnemyKinematics::integrate(float rate) {
+    const size_t count = size();
+    for (size_t i = 0; i < count; ++i) {
+        const float scale = step[i] * rate * speedScale[i];
+        x[i] += hSpeed[i] * scale;
+        y[i] += vSpeed[i] * scale;
+    }
+}
+
+void EnemyKinematics::decayColor() {
+    const size_t count = size();
+    for (size_t i = 0; i < count; ++i) {
+        const bool fading = colorAmount[i] > 0.f;
+        colorTimer[i] += fading ? step[i] / 1000 : 0;
+        const bool fade = colorTimer[i] > 20;
+        colorTimer[i] -= fade ? 20 : 0;
+        colorAmount[i] -= fade ? 0.1f : 0.f;
+    }
+}
+
+bool EnemyKinematics::isColored(size_t index) const {
+    return colorAmount[index] > 0.f;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "simulationLod.hpp"
+#include <SFML/Graphics.hpp>
+#include <stdint.h>
+#include <vector>
+
+// The simulation state that enemies have in common, one array per field, so
+// that the passes run on every enemy each tick are flat loops over
+// contiguous floats that the compiler can vectorize. An enemy is an index,
+// and removing one moves the last enemy into its place, so a group that
+// keeps more arrays alongside has to do the same with them.
+class EnemyKinematics {
+public:
+    size_t size() const;
+    size_t add(float x, float y, float hSpeed, float vSpeed, uint8_t health);
+    void removeAt(size_t index);
+    void clear();
+    // Works out each enemy's step for this tick from its tier, which the
+    // group keeps up to date
+    void schedule(const SimulationLod &);
+    // Moves the enemies along their velocities by their steps, scaled by
+    // speedScale
+    void integrate(float rate);
+    // Fades the hit flash on the enemies by their steps, a tenth every 20ms
+    void decayColor();
+    bool isColored(size_t index) const;
+    std::vector<float> x, y, hSpeed, vSpeed, speedScale, colorAmount;
+    // step is in microseconds, backlog is SimulationLod's
+    std::vector<int32_t> colorTimer, step, backlog;
+    // state holds the group's own state enum, see ScootGroup::getState()
+    std::vector<uint8_t> health, state;
+    std::vector<SimulationLod::Tier> tier;
+};
+
+// A view's bounds grown by a margin, to test positions against
+struct ViewBounds {
+    ViewBounds(const sf::View & view, float margin);
+    bool contains(float x, float y) const {
+        return x > left && x < right && y > top && y < bottom;
+    }
+    float left, top, right, bottom;
+};
@@ -1,17 +1,45 @@
 #include "enemyPlacementFn.hpp"
-#include "Game.hpp"
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <stdio.h>
 
-void initEnemies(Game * gm) {
+// Takes the enemy's tile out of the empty locations. Some enemies stick to the
+// half of the map further from the teleporter more often than others.
+static Coordinate takeLocation(LevelLayout & layout, EnemyKind kind,
+                               rng::Generator & generator) {
+    auto & locations = layout.emptyLocations;
+    int locationSelect;
+    switch (kind) {
+    case EnemyKind::Scoot:
+    case EnemyKind::Turret:
+        locationSelect = rng::random<2>(generator)
+                             ? rng::random(generator, locations.size() / 2)
+                             : rng::random(generator, locations.size());
+        break;
+
+    case EnemyKind::Dasher:
+        locationSelect = rng::random<2>(generator)
+                             ? rng::random(generator, locations.size() / 2)
+                             : rng::random(generator, locations.size() / 2);
+        break;
+
+    default:
+        locationSelect = rng::random(generator, locations.size());
+        break;
+    }
+    const Coordinate c = locations[locationSelect];
+    locations[locationSelect] = locations.back();
+    locations.pop_back();
+    return c;
+}
+
+static void planEnemies(LevelLayout & layout, int currentLevel,
+                        rng::Generator & generator) {
     enum EnemyId { Scoot, Critter, Dasher, Turret };
     constexpr static std::array<int, 4> targetLevel = {{
         4 /*Scoot*/, 5 /*Critter*/, 20 /*Dasher*/, 28 /*Turrets*/
     }};
-    int currentLevel = gm->getLevel();
-    enemyController & enemies = gm->getEnemyController();
-    tileController & tiles = gm->getTileController();
     std::vector<std::pair<int, int>> enemySelectVec;
     if (currentLevel >= 1) {
         enemySelectVec.emplace_back(1, std::abs(currentLevel - targetLevel[0]));
@@ -48,7 +76,7 @@ void initEnemies(Game * gm) {
     for (int i = 0; i < iters; i++) {
         // Generate a random number on the range of 0 to the sum of all enemy
         // weights
-        int select = rng::random(std::max(collector, 1));
+        int select = rng::random(generator, std::max(collector, 1));
         // Find the interval that the selected value falls into in intervals[]
         int selectedIndex = 0;
         for (size_t i = 0; i < enemyVecLen; i++) {
@@ -67,17 +95,23 @@ void initEnemies(Game * gm) {
         // Now place enemies based on the selected index
         switch (selectedIndex) {
         case Scoot:
-            enemies.addScoot(&tiles);
+            layout.enemies.push_back(
+                {EnemyKind::Scoot,
+                 takeLocation(layout, EnemyKind::Scoot, generator)});
             break;
 
         case Critter:
-            enemies.addCritter(&tiles);
+            layout.enemies.push_back(
+                {EnemyKind::Critter,
+                 takeLocation(layout, EnemyKind::Critter, generator)});
             break;
 
         case Dasher: {
             static const unsigned maxDashers(5);
             if (numPlaced[Dasher] < maxDashers) {
-                enemies.addDasher(&tiles);
+                layout.enemies.push_back(
+                    {EnemyKind::Dasher,
+                     takeLocation(layout, EnemyKind::Dasher, generator)});
                 ++numPlaced[Dasher];
             } else {
                 --i;
@@ -88,7 +122,9 @@ void initEnemies(Game * gm) {
         case Turret: {
             static const unsigned maxTurrets(3);
             if (numPlaced[Turret] < maxTurrets) {
-                enemies.addTurret(&tiles);
+                layout.enemies.push_back(
+                    {EnemyKind::Turret,
+                     takeLocation(layout, EnemyKind::Turret, generator)});
                 ++numPlaced[Turret];
             } else {
                 --i;
@@ -101,3 +137,32 @@ void initEnemies(Game * gm) {
         }
     }
 }
+
+void planLevelContents(LevelLayout & layout, int level,
+                       rng::Generator & generator) {
+    layout.enemies.clear();
+    planEnemies(layout, level, generator);
+    auto & locations = layout.emptyLocations;
+    layout.hasChest = !locations.empty();
+    if (layout.hasChest) {
+        const int locationSelect = rng::random(generator, locations.size());
+        layout.chest = locations[locationSelect];
+        locations[locationSelect] = locations.back();
+        locations.pop_back();
+        if (level < 7) {
+            layout.chestContents =
+                static_cast<Powerup>(rng::random<2, 1>(generator));
+        } else {
+            layout.chestContents =
+                static_cast<Powerup>(rng::random<3, 2>(generator));
+        }
+    }
+    // The terminal goes somewhere in the third of the map furthest from the
+    // teleporter, and doesn't use up the tile
+    layout.hasTerminal = !rng::random<2>(generator);
+    if (layout.hasTerminal) {
+        const size_t vecSize = locations.size();
+        const int locationSel = rng::random(generator, vecSize / 3);
+        layout.terminal = locations[vecSize - 1 - locationSel];
+    }
+}
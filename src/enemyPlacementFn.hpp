@@ -1,5 +1,9 @@
 #pragma once
 
-class Game;
+#include "levelGenerator.hpp"
 
-void initEnemies(Game *);
+// Picks the enemies, the treasure chest and the terminal for a generated
+// layout. Deeper levels get more and nastier enemies. Like the rest of level
+// generation, this doesn't touch any game state.
+void planLevelContents(LevelLayout & layout, int level,
+                       rng::Generator & generator);
@@ -44,7 +44,7 @@ public:
         if (timer > lifetime) {
             setKillFlag();
         }
-        float offset = rng::random<20>();
+        float offset = rng::random<20>(rng::Stream::fx);
         glowSprite.setColor(
             sf::Color(230 + offset, 230 + offset, 230 + offset, 255));
         spriteSheet.setPosition(position.x, position.y);
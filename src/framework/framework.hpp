@@ -16,10 +16,14 @@ using Sprite = sf::Sprite;
 // with the rest of the templates in this header.            //
 //===========================================================//
 class Object {
+public:
+    // How close to the view the object was when the scene was last culled,
+    // nearest first. Each is a ring around the one before it.
+    enum class Proximity : uint8_t { onScreen, visible, nearby, distant };
 protected:
     sf::Vector2f position{};
     bool killFlag = false;
-    bool visible = false;
+    Proximity proximity = Proximity::distant;
 public:
     Object(float x, float y) : position{sf::Vector2f{x, y}} {}
     virtual ~Object() {}
@@ -39,11 +43,20 @@ public:
     inline void setKillFlag(bool _killFlag = true) {
 	killFlag = _killFlag;
     }
-    inline bool isVisible() {
-	return visible;
+    inline Proximity getProximity() const {
+	return proximity;
+    }
+    inline bool isOnScreen() const {
+	return proximity == Proximity::onScreen;
+    }
+    inline bool isVisible() const {
+	return proximity <= Proximity::visible;
+    }
+    inline bool isNearby() const {
+	return proximity <= Proximity::nearby;
     }
-    inline void setVisibility(bool _visible) {
-	visible = _visible;
+    inline void setProximity(Proximity _proximity) {
+	proximity = _proximity;
     }
 };
 
@@ -0,0 +1,75 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//==========================================================================//
+// A fixed size pool of worker threads fed from a single job queue. Jobs    //
+// are submitted as callables, and WorkerPool::submit() returns a future    //
+// for the result. Exceptions thrown by a job are stored in its future, so  //
+// the caller rethrows them on its own thread when calling get(). The       //
+// destructor drains the queue and joins all of the workers.                //
+//==========================================================================//
+
+class WorkerPool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable jobsCond;
+    bool stopping = false;
+    void run() {
+	while (true) {
+	    std::function<void()> job;
+	    {
+		std::unique_lock<std::mutex> lk(jobsMutex);
+		jobsCond.wait(lk, [this] { return stopping || !jobs.empty(); });
+		if (jobs.empty()) {
+		    return;
+		}
+		job = std::move(jobs.front());
+		jobs.pop_front();
+	    }
+	    job();
+	}
+    }
+public:
+    explicit WorkerPool(unsigned count = std::thread::hardware_concurrency()) {
+	if (count == 0) {
+	    count = 1;
+	}
+	for (unsigned i = 0; i < count; ++i) {
+	    workers.emplace_back([this] { run(); });
+	}
+    }
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool & operator=(const WorkerPool &) = delete;
+    template <typename F>
+    auto submit(F && f) -> std::future<decltype(f())> {
+	using ResultType = decltype(f());
+	auto task = std::make_shared<std::packaged_task<ResultType()>>(
+	    std::forward<F>(f));
+	std::future<ResultType> result = task->get_future();
+	{
+	    std::lock_guard<std::mutex> lk(jobsMutex);
+	    jobs.emplace_back([task] { (*task)(); });
+	}
+	jobsCond.notify_one();
+	return result;
+    }
+    size_t size() const { return workers.size(); }
+    ~WorkerPool() {
+	{
+	    std::lock_guard<std::mutex> lk(jobsMutex);
+	    stopping = true;
+	}
+	jobsCond.notify_all();
+	for (auto & worker : workers) {
+	    worker.join();
+	}
+    }
+};
@@ -0,0 +1,34 @@
+#include "hitStop.hpp"
+#include <algorithm>
+
+HitStop::HitStop() : scale(1.f) {}
+
+void HitStop::start(const sf::Time & duration, float scale) {
+    if (isActive()) {
+        this->scale = std::min(this->scale, scale);
+    } else {
+        this->scale = scale;
+    }
+    remaining = std::max(remaining, duration);
+}
+
+sf::Time HitStop::apply(const sf::Time & elapsed) {
+    if (!isActive()) {
+        return elapsed;
+    }
+    // A tick can straddle the end of the stop
+    const sf::Time stopped = std::min(elapsed, remaining);
+    remaining -= stopped;
+    const sf::Time result = stopped * scale + (elapsed - stopped);
+    if (!isActive()) {
+        scale = 1.f;
+    }
+    return result;
+}
+
+bool HitStop::isActive() const { return remaining > sf::Time::Zero; }
+
+void HitStop::reset() {
+    remaining = sf::Time::Zero;
+    scale = 1.f;
+}
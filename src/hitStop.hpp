@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SFML/System.hpp>
+
+// Freezes or slows down the simulation for a moment, e.g. to give a kill some
+// weight. Instead of sleeping, the logic thread keeps ticking and shrinks the
+// time it hands to the game, so the renderer never waits on it. Stops that
+// overlap merge into one: it lasts until the latest of their ends, at the
+// slowest of their scales, so a burst of kills doesn't add up to a long
+// freeze. Only used from the logic thread.
+class HitStop {
+public:
+    HitStop();
+    // Scale is how fast the game runs meanwhile, zero freezes it
+    void start(const sf::Time & duration, float scale = 0.f);
+    // Takes the real time since the last tick, and returns the time that the
+    // game should advance by
+    sf::Time apply(const sf::Time & elapsed);
+    bool isActive() const;
+    void reset();
+
+private:
+    sf::Time remaining;
+    float scale;
+};
@@ -1,9 +1,9 @@
 #pragma once
 
-#include "coordinate.hpp"
-#include "wall.hpp"
-#include <SFML/Graphics.hpp>
+#include "rng.hpp"
 
-class tileController;
+struct LevelLayout;
 
-void initMapVectors(tileController *);
+// Picks the teleporter and the spawn point of a generated map, and collects
+// its walls and open tiles
+void initMapVectors(LevelLayout & layout, rng::Generator & generator);
@@ -1,4 +1,6 @@
 #include "inputController.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 
@@ -24,7 +26,15 @@ static sf::Keyboard::Key toSfKey(const std::string & strKey) {
     return ::translator[strKey];
 }
 
-InputController::InputController(nlohmann::json & config) {
+static int64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+InputController::InputController(nlohmann::json & config)
+    : publishedMask(0), pressTimes{}, tickMask(0), pendingPress(0),
+      reflectedPress(0), latencies{}, latencyCount(0), replaying(false) {
     try {
         auto it = config.find("Keyboard");
         const auto mapKey = [this, it](const int keyIndex,
@@ -82,34 +92,115 @@ void InputController::mapJoystickButton(const uint32_t button,
 }
 
 bool InputController::pausePressed() const {
-    return keyMask[indexPause] || joystickMask[indexPause];
+    return tickMask.load(std::memory_order_relaxed) & (1 << indexPause);
 }
 
 bool InputController::shootPressed() const {
-    return keyMask[indexShoot] || joystickMask[indexShoot];
+    return tickMask.load(std::memory_order_relaxed) & (1 << indexShoot);
 }
 
 bool InputController::actionPressed() const {
-    return keyMask[indexAction] || joystickMask[indexAction];
+    return tickMask.load(std::memory_order_relaxed) & (1 << indexAction);
 }
 
 bool InputController::leftPressed() const {
-    return keyMask[indexLeft] || joystickMask[indexLeft];
+    return tickMask.load(std::memory_order_relaxed) & (1 << indexLeft);
 }
 
 bool InputController::rightPressed() const {
-    return keyMask[indexRight] || joystickMask[indexRight];
+    return tickMask.load(std::memory_order_relaxed) & (1 << indexRight);
 }
 
 bool InputController::upPressed() const {
-    return keyMask[indexUp] || joystickMask[indexUp];
+    return tickMask.load(std::memory_order_relaxed) & (1 << indexUp);
 }
 
 bool InputController::downPressed() const {
-    return keyMask[indexDown] || joystickMask[indexDown];
+    return tickMask.load(std::memory_order_relaxed) & (1 << indexDown);
+}
+
+uint8_t InputController::sample() {
+    if (!replaying) {
+        const uint8_t previous = tickMask.load(std::memory_order_relaxed);
+        const uint8_t current = publishedMask.load(std::memory_order_acquire);
+        const uint8_t pressed = current & ~previous;
+        if (pressed && !pendingPress) {
+            // Several buttons may have gone down since the last tick, the
+            // latency is measured from the first of them
+            for (size_t i = 0; i < indexCount; ++i) {
+                if (pressed & (1 << i)) {
+                    const int64_t time =
+                        pressTimes[i].load(std::memory_order_relaxed);
+                    if (!pendingPress || time < pendingPress) {
+                        pendingPress = time;
+                    }
+                }
+            }
+        }
+        tickMask.store(current, std::memory_order_relaxed);
+    }
+    return tickMask.load(std::memory_order_relaxed);
+}
+
+void InputController::setMask(uint8_t mask) {
+    replaying = true;
+    tickMask.store(mask, std::memory_order_relaxed);
+}
+
+void InputController::tickComplete() {
+    if (pendingPress) {
+        // Only the oldest press still waiting for a frame is measured
+        int64_t expected = 0;
+        reflectedPress.compare_exchange_strong(expected, pendingPress,
+                                               std::memory_order_release);
+        pendingPress = 0;
+    }
+}
+
+int64_t InputController::takeReflectedPress() {
+    return reflectedPress.exchange(0, std::memory_order_acquire);
+}
+
+void InputController::framePresented(int64_t pressTime) {
+    if (!pressTime) {
+        return;
+    }
+    latencies[latencyCount % latencies.size()] =
+        (nowMicros() - pressTime) / 1000.f;
+    ++latencyCount;
+}
+
+InputController::LatencyStats InputController::getLatencyStats() const {
+    LatencyStats stats{0.f, 0.f, std::min(latencyCount, latencies.size())};
+    for (size_t i = 0; i < stats.samples; ++i) {
+        stats.meanMillis += latencies[i];
+        stats.maxMillis = std::max(stats.maxMillis, latencies[i]);
+    }
+    if (stats.samples) {
+        stats.meanMillis /= stats.samples;
+    }
+    return stats;
+}
+
+void InputController::publish(uint8_t pressed) {
+    if (pressed) {
+        const int64_t now = nowMicros();
+        for (size_t i = 0; i < indexCount; ++i) {
+            if (pressed & (1 << i)) {
+                pressTimes[i].store(now, std::memory_order_relaxed);
+            }
+        }
+    }
+    publishedMask.store(
+        static_cast<uint8_t>((keyMask | joystickMask).to_ulong()),
+        std::memory_order_release);
 }
 
 void InputController::recordEvent(const sf::Event & event) {
+    if (replaying) {
+        return;
+    }
+    const auto before = keyMask | joystickMask;
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == keyboardMappings[indexPause]) {
             keyMask[indexPause] = true;
@@ -203,4 +294,8 @@ void InputController::recordEvent(const sf::Event & event) {
             joystickMask.reset();
         }
     }
+    const auto after = keyMask | joystickMask;
+    if (after != before) {
+        publish(static_cast<uint8_t>((after & ~before).to_ulong()));
+    }
 }
@@ -3,7 +3,9 @@
 #include "shutdownSignal.hpp"
 #include <SFML/Graphics.hpp>
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <stdint.h>
 #include <json.hpp>
 #include <unordered_map>
 
@@ -28,6 +30,32 @@ public:
     void recordEvent(const sf::Event &);
     void mapKeyboardKey(const sf::Keyboard::Key, const uint8_t);
     void mapJoystickButton(const uint32_t, const uint8_t);
+    // The *Pressed() queries read a snapshot of the input, taken once per
+    // logic tick, so that a tick sees the same input throughout. sample()
+    // takes the snapshot and returns it as a mask with one bit per button,
+    // and setMask() drives the input from a replay instead, after which
+    // events from the window are ignored.
+    //
+    // Events are recorded on the main thread, which publishes the buttons'
+    // state to the logic thread as a single atomic mask as soon as each
+    // event comes in, along with the time each button was last pressed.
+    uint8_t sample();
+    void setMask(uint8_t mask);
+    // Input to present latency. The logic thread calls tickComplete() after
+    // each tick, which hands the first press that the tick reacted to over
+    // to the main thread. The main thread calls takeReflectedPress() before
+    // drawing a frame, and framePresented() with the result once the frame
+    // is on screen.
+    void tickComplete();
+    int64_t takeReflectedPress();
+    void framePresented(int64_t pressTime);
+    struct LatencyStats {
+        float meanMillis;
+        float maxMillis;
+        size_t samples;
+    };
+    // Over the last few dozen presses, main thread only
+    LatencyStats getLatencyStats() const;
 
 private:
     enum {
@@ -41,8 +69,19 @@ private:
         indexCount
     };
     void remapJoystick();
+    void publish(uint8_t pressed);
+    // Written by the main thread only
     std::bitset<indexCount> keyMask;
     std::bitset<indexCount> joystickMask;
+    std::atomic<uint8_t> publishedMask;
+    std::array<std::atomic<int64_t>, indexCount> pressTimes;
+    // Written by the logic thread only, but the main thread reads it too
+    std::atomic<uint8_t> tickMask;
+    int64_t pendingPress;
+    std::atomic<int64_t> reflectedPress;
+    std::array<float, 64> latencies;
+    size_t latencyCount;
+    std::atomic<bool> replaying;
     std::array<uint32_t, 3> joystickMappings;
     std::array<sf::Keyboard::Key, 7> keyboardMappings;
     std::vector<JoystickInfo> joysticks;
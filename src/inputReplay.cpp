@@ -0,0 +1,88 @@
+#include "inputReplay.hpp"
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+static const char replayMagic[4] = {'B', 'J', 'R', 'P'};
+static const size_t replayHeaderSize = 4 + 4 + 8 + 4 + 4;
+
+template <typename T>
+static void writeLittleEndian(std::ofstream & out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.put(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+template <typename T> static T readLittleEndian(const uint8_t * in) {
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(in[i]) << (i * 8);
+    }
+    return value;
+}
+
+ReplayRecorder::ReplayRecorder(const std::string & path, uint64_t seed,
+                               const sf::Vector2u & windowSize)
+    : file(path, std::ios::binary | std::ios::trunc) {
+    if (!file) {
+        throw std::runtime_error("replay: unable to create " + path);
+    }
+    file.write(replayMagic, sizeof replayMagic);
+    writeLittleEndian<uint32_t>(file, replayVersion);
+    writeLittleEndian<uint64_t>(file, seed);
+    writeLittleEndian<uint32_t>(file, windowSize.x);
+    writeLittleEndian<uint32_t>(file, windowSize.y);
+}
+
+void ReplayRecorder::record(const sf::Time & elapsedTime, uint8_t mask) {
+    uint64_t elapsed = static_cast<uint64_t>(elapsedTime.asMicroseconds());
+    do {
+        const uint8_t byte = elapsed & 0x7f;
+        elapsed >>= 7;
+        file.put(static_cast<char>(elapsed ? byte | 0x80 : byte));
+    } while (elapsed);
+    file.put(static_cast<char>(mask));
+}
+
+ReplayPlayer::ReplayPlayer(const std::string & path)
+    : position(replayHeaderSize), ticksPlayed(0) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("replay: unable to open " + path);
+    }
+    data.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+    if (data.size() < replayHeaderSize ||
+        std::memcmp(data.data(), replayMagic, sizeof replayMagic) != 0 ||
+        readLittleEndian<uint32_t>(&data[4]) != replayVersion) {
+        throw std::runtime_error("replay: " + path + " is not a replay");
+    }
+    seed = readLittleEndian<uint64_t>(&data[8]);
+    windowSize.x = readLittleEndian<uint32_t>(&data[16]);
+    windowSize.y = readLittleEndian<uint32_t>(&data[20]);
+}
+
+uint64_t ReplayPlayer::getSeed() const { return seed; }
+
+const sf::Vector2u & ReplayPlayer::getWindowSize() const { return windowSize; }
+
+bool ReplayPlayer::next(sf::Time & elapsedTime, uint8_t & mask) {
+    uint64_t elapsed = 0;
+    for (unsigned shift = 0; position < data.size() && shift < 64;
+         shift += 7) {
+        const uint8_t byte = data[position++];
+        elapsed |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            if (position == data.size()) {
+                break; // Truncated, the mask never made it to disk
+            }
+            mask = data[position++];
+            elapsedTime = sf::microseconds(static_cast<sf::Int64>(elapsed));
+            ++ticksPlayed;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ReplayPlayer::getTicksPlayed() const { return ticksPlayed; }
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SFML/System.hpp>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// A replay is the run's seed, the window size, and the input mask and
+// elapsed time of every logic tick, which is enough to play a run back
+// exactly. Layout:
+//
+//   "BJRP" | version | seed | window width | window height | ticks...
+//
+// where each tick is its elapsed time in microseconds as a LEB128 varint,
+// followed by the input mask byte. Fixed size fields are little endian.
+
+static const uint32_t replayVersion = 1;
+
+class ReplayRecorder {
+public:
+    ReplayRecorder(const std::string & path, uint64_t seed,
+                   const sf::Vector2u & windowSize);
+    void record(const sf::Time & elapsedTime, uint8_t mask);
+
+private:
+    std::ofstream file;
+};
+
+class ReplayPlayer {
+public:
+    explicit ReplayPlayer(const std::string & path);
+    uint64_t getSeed() const;
+    const sf::Vector2u & getWindowSize() const;
+    // Returns false once every tick has been played
+    bool next(sf::Time & elapsedTime, uint8_t & mask);
+    size_t getTicksPlayed() const;
+
+private:
+    std::vector<uint8_t> data;
+    size_t position;
+    size_t ticksPlayed;
+    uint64_t seed;
+    sf::Vector2u windowSize;
+};
@@ -4,9 +4,14 @@
 #include "math.hpp"
 #include "util.hpp"
 #include <SFML/Graphics.hpp>
+#include <functional>
 
-inline void dispIntroSequence(sf::RenderWindow & window,
-                              InputController & input) {
+// The intro sequence only needs the fonts, so it's used to cover the rest of
+// the startup work. loadStep is called once per frame, and should return the
+// game's input controller once there is one to forward events to.
+inline void
+dispIntroSequence(sf::RenderWindow & window,
+                  const std::function<InputController *()> & loadStep) {
     const sf::Font & cornerstone =
         getgResHandlerPtr()->getFont(ResHandler::Font::cornerstone);
     sf::Text introText("A Game by Evan Bowman", cornerstone);
@@ -27,6 +32,7 @@ inline void dispIntroSequence(sf::RenderWindow & window,
     enum class State { dormant, textIn, pause1, textOut, pause2 };
     State state = State::dormant;
     while (window.isOpen()) {
+        InputController * input = loadStep();
         sf::Event event;
         while (window.pollEvent(event)) {
             switch (event.type) {
@@ -36,7 +42,9 @@ inline void dispIntroSequence(sf::RenderWindow & window,
                 break;
 
             default:
-                input.recordEvent(event);
+                if (input) {
+                    input->recordEvent(event);
+                }
                 break;
             }
         }
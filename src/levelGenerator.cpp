@@ -0,0 +1,66 @@
+#include "levelGenerator.hpp"
+#include "initMapVectors.hpp"
+#include "lightingMap.hpp"
+#include "pillarPlacement.h"
+
+// Picks which plates get a grate, grates tend to cluster together
+static void planGrates(LevelLayout & layout, rng::Generator & generator) {
+    const int width = layout.map.getWidth();
+    const int height = layout.map.getHeight();
+    auto & grates = layout.grates;
+    grates.resize(width, height);
+    for (int i = 0; i < width; i++) {
+        for (int j = 0; j < height; j++) {
+            if (layout.map(i, j) == Tile::Plate &&
+                !rng::random<11>(generator)) {
+                grates(i, j) = 1;
+            }
+        }
+    }
+    // Run 2 repetitions of smoothing
+    for (int rep = 2; rep > 0; rep--) {
+        for (int i = 1; i < width - 1; i++) {
+            for (int j = 1; j < height - 1; j++) {
+                const int count = grates(i - 1, j) + grates(i + 1, j) +
+                                  grates(i, j - 1) + grates(i, j + 1);
+                if (count && !rng::random<3>(generator)) {
+                    grates(i, j) = 1;
+                }
+            }
+        }
+    }
+}
+
+// The map image leaves out a margin around the map, where there is never
+// anything to draw
+static void planVariants(LevelLayout & layout, rng::Generator & generator) {
+    const int width = layout.map.getWidth();
+    const int height = layout.map.getHeight();
+    layout.variants.resize(width, height);
+    for (int i = mapImageMargin; i < width - mapImageMargin - 1; i++) {
+        for (int j = mapImageMargin; j < height - mapImageMargin - 1; j++) {
+            layout.variants(i, j) = rng::random<3>(generator);
+        }
+    }
+}
+
+void generateLevelLayout(LevelLayout & layout, rng::Generator & generator) {
+    layout.mapRetries = 0;
+    layout.overlayRetries = 0;
+    while (generateMap(layout.map, generator, layout.overlayRetries) < 150) {
+        ++layout.mapRetries;
+    }
+    planGrates(layout, generator);
+    planVariants(layout, generator);
+    initMapVectors(layout, generator);
+    Circle teleporterFootprint;
+    teleporterFootprint.x = layout.teleporter.x;
+    teleporterFootprint.y = layout.teleporter.y;
+    teleporterFootprint.r = 50;
+    layout.rockPositions.clear();
+    getRockPositions(layout.map, layout.rockPositions, teleporterFootprint,
+                     generator);
+    layout.lightPositions.clear();
+    getLightingPositions(layout.map, layout.lightPositions,
+                         teleporterFootprint, generator);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "coordinate.hpp"
+#include "mappingFunctions.hpp"
+#include "powerup.hpp"
+#include "rng.hpp"
+#include "tileMap.hpp"
+#include "wall.hpp"
+#include <stdint.h>
+#include <vector>
+
+// The map chunks leave out this many tiles around the map's edges, plus
+// one more on the right and bottom, where there is never anything to draw
+static const int mapImageMargin = 10;
+
+enum class EnemyKind : uint8_t { Scoot, Critter, Dasher, Turret };
+
+struct EnemySpawn {
+    EnemyKind kind;
+    Coordinate position;
+};
+
+// Everything about a regular level that comes out of the generator. Building
+// one doesn't touch SFML or any game state, so it can happen on any thread,
+// and the same generator state always gives the same level.
+struct LevelLayout {
+    TileMap map;
+    // Art choices for the map image: which plates get a grate, and which
+    // variant of the edge and grass art each tile uses. Both are the size of
+    // the map.
+    Grid<uint8_t> grates;
+    Grid<uint8_t> variants;
+    Coordinate teleporter;
+    Coordinate spawn;
+    // Open tiles, sorted by distance from the teleporter, minus the spawn
+    std::vector<Coordinate> emptyLocations;
+    std::vector<wall> walls;
+    std::vector<Coordinate> rockPositions;
+    std::vector<Coordinate> lightPositions;
+    // Rejected maps (under 150 center tiles) and grass overlays (under 300
+    // plates) along the way
+    int mapRetries;
+    int overlayRetries;
+    // Filled in by planLevelContents() (enemyPlacementFn.hpp), the tiles they stand on are taken out
+    // of emptyLocations
+    std::vector<EnemySpawn> enemies;
+    bool hasChest;
+    Coordinate chest;
+    Powerup chestContents;
+    bool hasTerminal;
+    Coordinate terminal;
+};
+
+void generateLevelLayout(LevelLayout & layout, rng::Generator & generator);
@@ -0,0 +1,39 @@
+#include "levelPrefetcher.hpp"
+#include "enemyPlacementFn.hpp"
+
+std::unique_ptr<PreparedLevel> prepareLevel(int level) {
+    auto prepared = std::make_unique<PreparedLevel>();
+    prepared->seed = rng::getSeed();
+    prepared->level = level;
+    // Same as reseeding the mapgen stream with the level number
+    prepared->generator = rng::makeGenerator(rng::Stream::mapgen, level);
+    generateLevelLayout(prepared->layout, prepared->generator);
+    planLevelContents(prepared->layout, level, prepared->generator);
+    prepared->art = MapChunks::prepare(prepared->layout);
+    return prepared;
+}
+
+LevelPrefetcher::LevelPrefetcher()
+    : pendingLevel(-1), pendingSeed(0), workers(1) {}
+
+void LevelPrefetcher::request(int level) {
+    if (pending.valid() && pendingLevel == level &&
+        pendingSeed == rng::getSeed()) {
+        return;
+    }
+    // An abandoned future doesn't wait for its job, the job just finishes
+    // unobserved
+    pendingLevel = level;
+    pendingSeed = rng::getSeed();
+    pending = workers.submit([level] { return prepareLevel(level); });
+}
+
+std::unique_ptr<PreparedLevel> LevelPrefetcher::take(int level) {
+    if (pending.valid() && pendingLevel == level) {
+        auto prepared = pending.get();
+        if (prepared->seed == rng::getSeed()) {
+            return prepared;
+        }
+    }
+    return prepareLevel(level);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "framework/workerPool.hpp"
+#include "levelGenerator.hpp"
+#include "mapChunks.hpp"
+#include "rng.hpp"
+#include <future>
+#include <memory>
+#include <stdint.h>
+
+// Everything Game::nextLevel() needs to build a regular level, short of the
+// GPU textures and the game objects themselves.
+struct PreparedLevel {
+    uint64_t seed;
+    int level;
+    LevelLayout layout;
+    MapChunks::Prepared art;
+    // The mapgen stream as level generation left it, the game objects that
+    // nextLevel() creates keep drawing from it
+    rng::Generator generator;
+};
+
+// Builds a level the same way whether or not it's done ahead of time
+std::unique_ptr<PreparedLevel> prepareLevel(int level);
+
+// Generates the next level on a worker thread while the current one is being
+// played, so that the teleporter transition doesn't wait on the generator.
+class LevelPrefetcher {
+public:
+    LevelPrefetcher();
+    LevelPrefetcher(const LevelPrefetcher &) = delete;
+    LevelPrefetcher & operator=(const LevelPrefetcher &) = delete;
+    // Starts preparing level in the background, replacing any earlier
+    // request. Does nothing if level is already on its way.
+    void request(int level);
+    // Returns level, waiting for it if it's still in the works. If it was
+    // never requested, or the run seed changed since, it's prepared on the
+    // calling thread instead.
+    std::unique_ptr<PreparedLevel> take(int level);
+
+private:
+    int pendingLevel;
+    uint64_t pendingSeed;
+    std::future<std::unique_ptr<PreparedLevel>> pending;
+    WorkerPool workers;
+};
@@ -2,7 +2,8 @@
 
 #include "coordinate.hpp"
 #include "rng.hpp"
-#include <cmath>
+#include "tileMap.hpp"
+#include <algorithm>
 #include <vector>
 
 #define CIRC_RADIUS 200
@@ -13,68 +14,89 @@ struct Circle {
     int r;
 };
 
-bool checkOverlap(Circle c1, Circle c2) {
-    double centerDifference =
-        sqrt((double)(32 * (c1.x - c2.x)) * (32 * (c1.x - c2.x)) +
-             (26 * (c1.y - c2.y)) * (26 * (c1.y - c2.y)));
-    if (centerDifference <= (double)c1.r || centerDifference <= (double)c2.r) {
-        return true;
+// Circles overlap when either one's radius reaches the other's center. Tiles
+// are 32 by 26 pixels, and the distances are compared squared.
+inline bool checkOverlap(Circle c1, Circle c2) {
+    const int dx = 32 * (c1.x - c2.x);
+    const int dy = 26 * (c1.y - c2.y);
+    const int r = std::max(c1.r, c2.r);
+    return dx * dx + dy * dy <= r * r;
+}
+
+// Walks the circles in order, keeping each one that doesn't overlap a circle
+// kept before it, and adds the kept circles' centers to availableLocations.
+// Kept circles are bucketed in a grid with cells wider than the largest
+// radius, so a circle only needs to be checked against the 3x3 cells around
+// it, rather than against every other circle.
+inline void selectSpacedCircles(const std::vector<Circle> & circles,
+                                const TileMap & gameMap,
+                                std::vector<Coordinate> & availableLocations) {
+    int maxRadius = 0;
+    for (const auto & circle : circles) {
+        maxRadius = std::max(maxRadius, circle.r);
+    }
+    const int cellWidth = maxRadius / 32 + 1;
+    const int cellHeight = maxRadius / 26 + 1;
+    const int cols = gameMap.getWidth() / cellWidth + 1;
+    const int rows = gameMap.getHeight() / cellHeight + 1;
+    // Each cell is a linked list threaded through the kept circles
+    std::vector<int> cellHeads(cols * rows, -1);
+    std::vector<Circle> kept;
+    std::vector<int> next;
+    for (const auto & circle : circles) {
+        const int col = circle.x / cellWidth;
+        const int row = circle.y / cellHeight;
+        const int colEnd = std::min(col + 1, cols - 1);
+        const int rowEnd = std::min(row + 1, rows - 1);
+        bool overlaps = false;
+        for (int c = std::max(col - 1, 0); c <= colEnd && !overlaps; ++c) {
+            for (int r = std::max(row - 1, 0); r <= rowEnd && !overlaps; ++r) {
+                for (int k = cellHeads[c * rows + r]; k != -1; k = next[k]) {
+                    if (checkOverlap(circle, kept[k])) {
+                        overlaps = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (!overlaps) {
+            next.push_back(cellHeads[col * rows + row]);
+            cellHeads[col * rows + row] = kept.size();
+            kept.push_back(circle);
+        }
+    }
+    for (const auto & circle : kept) {
+        Coordinate c;
+        c.x = circle.x;
+        c.y = circle.y;
+        availableLocations.push_back(c);
     }
-    return false;
 }
 
-void getLightingPositions(Tile gameMap[61][61],
-                          std::vector<Coordinate> & availableLocations,
-                          Circle & teleporterFootprint) {
-    // First create a temporary map containing only the surfaces from the game
-    // map
+inline void getLightingPositions(const TileMap & gameMap,
+                                 std::vector<Coordinate> & availableLocations,
+                                 Circle & teleporterFootprint,
+                                 rng::Generator & generator) {
+    // First collect the surfaces from the game map that aren't too close to
+    // the teleporter
     std::vector<Circle> lightMap;
-    int i, j;
-    for (i = 0; i < 61; i++) {
-        for (j = 0; j < 61; j++) {
-            Circle c;
-            if (gameMap[i][j] == Tile::Sand || gameMap[i][j] == Tile::SandAndGrass ||
-                gameMap[i][j] == Tile::Grass || gameMap[i][j] == Tile::GrassFlowers) {
+    for (int i = 0; i < gameMap.getWidth(); i++) {
+        for (int j = 0; j < gameMap.getHeight(); j++) {
+            const Tile tile = gameMap(i, j);
+            if (tile == Tile::Sand || tile == Tile::SandAndGrass ||
+                tile == Tile::Grass || tile == Tile::GrassFlowers) {
+                Circle c;
                 c.x = i;
                 c.y = j;
-                c.r = CIRC_RADIUS + rng::random<40>();
-                lightMap.push_back(c);
+                c.r = CIRC_RADIUS + rng::random<40>(generator);
+                if (!checkOverlap(teleporterFootprint, c)) {
+                    lightMap.push_back(c);
+                }
             }
         }
     }
-
-    for (std::vector<Circle>::iterator it = lightMap.begin();
-         it != lightMap.end();) {
-        if (checkOverlap(teleporterFootprint, *it)) {
-            it = lightMap.erase(it);
-        } else {
-            ++it;
-        }
-    }
-
-    size_t length = lightMap.size();
     // Randomly shuffle the vector so not to just pick elements that are
     // spatially close
-    std::random_shuffle(lightMap.begin(), lightMap.end());
-    for (size_t i = 0; i < length; i++) {
-        // Remove all intersecting circles
-        for (std::vector<Circle>::iterator it = lightMap.begin();
-             it != lightMap.end();) {
-            if (checkOverlap(lightMap[i], *it) &&
-                (it->x != lightMap[i].x || it->y != lightMap[i].y)) {
-                it = lightMap.erase(it);
-                length--;
-            } else {
-                ++it;
-            }
-        }
-    }
-
-    // Now add whatever's left to the vector of available coordinates
-    for (auto element : lightMap) {
-        Coordinate c;
-        c.x = element.x;
-        c.y = element.y;
-        availableLocations.push_back(c);
-    }
+    std::shuffle(lightMap.begin(), lightMap.end(), generator);
+    selectSpacedCircles(lightMap, gameMap, availableLocations);
 }
@@ -0,0 +1,61 @@
+#include "logicScheduler.hpp"
+#include <thread>
+
+static const microseconds activePeriod(2000);
+static const microseconds idlePeriod(33000);
+// How long after an input ticks stay at full rate, even when idle
+static const milliseconds inputGracePeriod(250);
+static const milliseconds statsWindow(1000);
+
+LogicScheduler::LogicScheduler()
+    : tickStart(high_resolution_clock::now()), windowStart(tickStart),
+      lastInput(tickStart), windowBusy(0), windowTicks(0), ticksPerSecond(0),
+      busyPercent(0), woken(false) {}
+
+void LogicScheduler::beginTick() { tickStart = high_resolution_clock::now(); }
+
+void LogicScheduler::endTick(bool idle) {
+    const time_point stop = high_resolution_clock::now();
+    const auto busy =
+        std::chrono::duration_cast<microseconds>(stop - tickStart);
+    windowBusy += busy;
+    ++windowTicks;
+    const auto windowLength =
+        std::chrono::duration_cast<microseconds>(stop - windowStart);
+    if (windowLength >= statsWindow) {
+        const float seconds = windowLength.count() / 1e6f;
+        ticksPerSecond.store(windowTicks / seconds, std::memory_order_relaxed);
+        busyPercent.store(100.f * windowBusy.count() / windowLength.count(),
+                          std::memory_order_relaxed);
+        windowStart = stop;
+        windowBusy = microseconds(0);
+        windowTicks = 0;
+    }
+    std::unique_lock<std::mutex> lk(wakeMutex);
+    if (woken) {
+        woken = false;
+        lastInput = stop;
+    }
+    if (!idle || stop - lastInput < inputGracePeriod) {
+        lk.unlock();
+        std::this_thread::sleep_for(activePeriod - busy);
+        return;
+    }
+    wakeCond.wait_for(lk, idlePeriod - busy, [this] { return woken; });
+}
+
+void LogicScheduler::wake() {
+    {
+        std::lock_guard<std::mutex> lk(wakeMutex);
+        woken = true;
+    }
+    wakeCond.notify_one();
+}
+
+float LogicScheduler::getTicksPerSecond() const {
+    return ticksPerSecond.load(std::memory_order_relaxed);
+}
+
+float LogicScheduler::getBusyPercent() const {
+    return busyPercent.load(std::memory_order_relaxed);
+}
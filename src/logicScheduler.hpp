@@ -0,0 +1,38 @@
+#pragma once
+
+#include "alias.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// Paces the logic thread. While the overworld is simulating, ticks run every
+// 2ms. While it's idle, e.g. behind a stashed pause menu, they drop to about
+// 30 a second, and any input brings them straight back to full rate. Also
+// keeps the tick rate and the fraction of time spent ticking, for the
+// profiler overlay.
+class LogicScheduler {
+public:
+    LogicScheduler();
+    // Call at the start of each tick
+    void beginTick();
+    // Call at the end of each tick, waits until the next one is due
+    void endTick(bool idle);
+    // Call on input, from any thread. Cuts an idle wait short, and keeps
+    // ticks at full rate for a little while.
+    void wake();
+    // Both over the last second or so, safe to call from any thread
+    float getTicksPerSecond() const;
+    float getBusyPercent() const;
+
+private:
+    time_point tickStart;
+    time_point windowStart;
+    time_point lastInput;
+    microseconds windowBusy;
+    int windowTicks;
+    std::atomic<float> ticksPerSecond;
+    std::atomic<float> busyPercent;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCond;
+    bool woken;
+};
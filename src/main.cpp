@@ -4,32 +4,172 @@
 #include "config.h"
 #include "framework/smartThread.hpp"
 #include "inputController.hpp"
+#include "inputReplay.hpp"
 #include "introSequence.hpp"
 #include "player.hpp"
+#include "profiler.hpp"
+#include "renderBenchmark.hpp"
 #include "resourceHandler.hpp"
 #include "rng.hpp"
 #include "util.hpp"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
+#include <atomic>
 #include <cmath>
 #include <exception>
 #include <fstream>
 #include <iostream>
 #include <json.hpp>
+#include <memory>
 #include <stdexcept>
+#include <string>
 
 std::exception_ptr pWorkerException = nullptr;
 
 #ifdef BLINDJUMP_WINDOWS
-int main();
-int WinMain(HINSTANCE, HINSTANCE, LPSTR, int) { return main(); }
+int main(int, char **);
+int WinMain(HINSTANCE, HINSTANCE, LPSTR, int) { return main(__argc, __argv); }
 #endif
 
-int main() {
-    rng::seed();
+static void reportLoadTimes(const ResHandler & resourceHandler) {
+    for (const auto & timing : resourceHandler.getLoadTimings()) {
+        std::cout << "load " << timing.name << " decode "
+                  << timing.decode.count() << "us upload "
+                  << timing.upload.count() << "us" << std::endl;
+    }
+    std::cout << "load total " << resourceHandler.getTotalLoadTime().count()
+              << "us" << std::endl;
+}
+
+static bool debugOptionEnabled(const nlohmann::json & config,
+                               const char * option) {
+    auto debugOptions = config.find("Debug");
+    if (debugOptions == config.end()) {
+        return false;
+    }
+    return debugOptions->value(option, false);
+}
+
+struct Options {
+    std::string recordPath;
+    std::string replayPath;
+    std::string tracePath;
+    bool headless = false;
+    int benchmarkLevels = 0;
+    bool seeded = false;
+    uint64_t seed = 0;
+};
+
+static bool parseOptions(int argc, char ** argv, Options & options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            options.replayPath = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--benchmark" && i + 1 < argc) {
+            options.benchmarkLevels = std::atoi(argv[++i]);
+            if (options.benchmarkLevels <= 0) {
+                return false;
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seeded = true;
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+    if (!options.recordPath.empty() && !options.replayPath.empty()) {
+        return false;
+    }
+    if (options.benchmarkLevels &&
+        (!options.recordPath.empty() || !options.replayPath.empty())) {
+        return false;
+    }
+    return !options.headless || !options.replayPath.empty();
+}
+
+// Records a profiler trace for the whole run, and writes it out however the
+// run ends. Should outlive the logic thread.
+class TraceRecording {
+public:
+    explicit TraceRecording(const std::string & path) : path(path) {
+        if (!path.empty()) {
+            profiler::startTrace();
+        }
+    }
+    ~TraceRecording() {
+        if (path.empty()) {
+            return;
+        }
+        try {
+            profiler::stopTrace(path);
+        } catch (const std::exception & ex) {
+            std::cerr << ex.what() << std::endl;
+        }
+    }
+
+private:
+    std::string path;
+};
+
+static void reportReplay(Game & game, const ReplayPlayer & replay,
+                         const microseconds & wallTime) {
+    const sf::Vector2f playerPos = game.getPlayer().getPosition();
+    std::cout << "replay " << replay.getTicksPlayed() << " ticks in "
+              << wallTime.count() << "us, level " << game.getLevel()
+              << ", player at " << playerPos.x << ", " << playerPos.y
+              << std::endl;
+}
+
+// Plays a replay back on the calling thread as fast as it can, without
+// drawing anything. The window only exists for its OpenGL context.
+static void runHeadless(Game & game, ReplayPlayer & replay) {
+    InputController & input = game.getInputController();
+    const time_point start = high_resolution_clock::now();
+    sf::Time elapsedTime;
+    uint8_t mask;
+    while (replay.next(elapsedTime, mask)) {
+        game.swapLevelIfPending();
+        input.setMask(mask);
+        game.updateLogic(elapsedTime);
+        sf::Event event;
+        while (game.getWindow().pollEvent(event)) {
+        }
+    }
+    reportReplay(game, replay,
+                 std::chrono::duration_cast<microseconds>(
+                     high_resolution_clock::now() - start));
+}
+
+int main(int argc, char ** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << EXECUTABLE_NAME
+                  << " [--record FILE | --replay FILE [--headless] |"
+                     " --benchmark LEVELS] [--seed SEED] [--trace FILE]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    // Benchmarks always run on the same levels
+    if (options.seeded || options.benchmarkLevels) {
+        rng::seed(options.seed);
+    } else {
+        rng::seed();
+    }
     ResHandler resourceHandler;
     try {
+        TraceRecording trace(options.tracePath);
+        std::unique_ptr<ReplayPlayer> replay;
+        if (!options.replayPath.empty()) {
+            replay = std::make_unique<ReplayPlayer>(options.replayPath);
+            rng::seed(replay->getSeed());
+        }
         nlohmann::json configJSON;
         try {
             std::fstream configRaw(resourcePath() + "config.json");
@@ -38,39 +178,126 @@ int main() {
             std::cerr << std::string("JSON error: ") + ex.what() << std::endl;
             return EXIT_FAILURE;
         }
-        resourceHandler.load();
+        sf::RenderWindow window;
+        if (replay) {
+            // The camera depends on the window size, so replays get the
+            // window they were recorded in
+            const sf::Vector2u & size = replay->getWindowSize();
+            window.create(sf::VideoMode(size.x, size.y), EXECUTABLE_NAME,
+                          sf::Style::Titlebar | sf::Style::Close,
+                          sf::ContextSettings(0, 0, 6));
+        } else if (options.benchmarkLevels) {
+            // A fixed size, so that runs on different machines draw the same
+            // number of pixels
+            window.create(sf::VideoMode(1280, 720), EXECUTABLE_NAME,
+                          sf::Style::Titlebar | sf::Style::Close,
+                          sf::ContextSettings(0, 0, 6));
+        } else {
+            window.create(sf::VideoMode::getDesktopMode(), EXECUTABLE_NAME,
+                          sf::Style::Fullscreen, sf::ContextSettings(0, 0, 6));
+        }
+        window.setVerticalSyncEnabled(true);
+        window.setFramerateLimit(120);
+        window.setMouseCursorVisible(false);
+        if (options.headless) {
+            window.setVisible(false);
+            resourceHandler.load();
+            setgResHandlerPtr(&resourceHandler);
+            Game game(configJSON, window);
+            game.setReplayMode(true);
+            game.getCamera().panDown();
+            runHeadless(game, *replay);
+            return EXIT_SUCCESS;
+        }
+        if (options.benchmarkLevels) {
+            window.setVisible(false);
+            window.setVerticalSyncEnabled(false);
+            window.setFramerateLimit(0);
+            resourceHandler.load();
+            setgResHandlerPtr(&resourceHandler);
+            Game game(configJSON, window);
+            runRenderBenchmark(game, options.benchmarkLevels);
+            return EXIT_SUCCESS;
+        }
+        resourceHandler.beginLoad();
         setgResHandlerPtr(&resourceHandler);
-        Game game(configJSON);
-        configJSON.clear();
-        dispIntroSequence(game.getWindow(), game.getInputController());
-        SmartThread logicThread([&game]() {
-            duration logicUpdateDelta;
+        // Everything besides the fonts streams in while the intro plays,
+        // leaving most of each frame to the intro itself
+        std::unique_ptr<Game> pGame;
+        auto loadStep = [&]() -> InputController * {
+            static const microseconds loadBudgetPerFrame(4000);
+            if (!pGame && resourceHandler.continueLoad(loadBudgetPerFrame)) {
+                pGame = std::make_unique<Game>(configJSON, window);
+                pGame->setProfilerHotkeyEnabled(
+                    debugOptionEnabled(configJSON, "Profiler"));
+                if (debugOptionEnabled(configJSON, "ReportLoadTimes")) {
+                    reportLoadTimes(resourceHandler);
+                }
+                configJSON.clear();
+            }
+            return pGame ? &pGame->getInputController() : nullptr;
+        };
+        dispIntroSequence(window, loadStep);
+        if (!pGame) {
+            resourceHandler.finishLoad();
+            loadStep();
+        }
+        Game & game = *pGame;
+        std::unique_ptr<ReplayRecorder> recorder;
+        if (!options.recordPath.empty()) {
+            recorder = std::make_unique<ReplayRecorder>(
+                options.recordPath, rng::getSeed(), window.getSize());
+        }
+        game.setReplayMode(recorder || replay);
+        std::atomic<bool> replayFinished(false);
+        const time_point replayStart = high_resolution_clock::now();
+        game.getCamera().panDown();
+        SmartThread logicThread([&game, &recorder, &replay,
+                                 &replayFinished]() {
+            LogicScheduler & scheduler = game.getLogicScheduler();
             sf::Clock gameClock;
+            InputController & input = game.getInputController();
             try {
-                while (game.getWindow().isOpen()) {
-                    time_point start = high_resolution_clock::now();
+                while (game.getWindow().isOpen() && !replayFinished) {
+                    scheduler.beginTick();
                     sf::Time elapsedTime = gameClock.restart();
                     // TODO: what if the game freezes? Elapsed time will be
                     // large...
-                    if (util::isAsleep) {
-                        elapsedTime = gameClock.restart();
-                        util::isAsleep = false;
+                    // Waiting doesn't count as a tick, so it isn't recorded,
+                    // and the time spent suspended isn't played either
+                    if (!game.hasWindowFocus()) {
+                        game.waitForFocus();
+                        gameClock.restart();
+                        continue;
+                    }
+                    if (game.isLevelSwapPending()) {
+                        game.waitForLevelSwap();
+                        gameClock.restart();
+                        continue;
+                    }
+                    if (replay) {
+                        uint8_t mask;
+                        if (!replay->next(elapsedTime, mask)) {
+                            replayFinished = true;
+                            break;
+                        }
+                        input.setMask(mask);
+                    } else {
+                        const uint8_t mask = input.sample();
+                        if (recorder) {
+                            recorder->record(elapsedTime, mask);
+                        }
                     }
                     game.updateLogic(elapsedTime);
-                    time_point stop = high_resolution_clock::now();
-                    logicUpdateDelta =
-                        std::chrono::duration_cast<nanoseconds>(stop - start);
-                    static const microseconds logicUpdateLimit(2000);
-                    std::this_thread::sleep_for(logicUpdateLimit -
-                                                logicUpdateDelta);
+                    input.tickComplete();
+                    scheduler.endTick(game.isIdle());
                 }
             } catch (...) {
                 ::pWorkerException = std::current_exception();
                 return;
             }
         });
-        game.getCamera().panDown();
-        while (game.getWindow().isOpen()) {
+        while (game.getWindow().isOpen() && !replayFinished) {
             game.updateGraphics();
             game.eventLoop();
             if (::pWorkerException) {
@@ -78,6 +305,11 @@ int main() {
                 std::rethrow_exception(::pWorkerException);
             }
         }
+        if (replay) {
+            reportReplay(game, *replay,
+                         std::chrono::duration_cast<microseconds>(
+                             high_resolution_clock::now() - replayStart));
+        }
     } catch (const ShutdownSignal & sig) {
         std::cout << sig.what() << std::endl;
         return EXIT_SUCCESS;
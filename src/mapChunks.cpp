@@ -0,0 +1,286 @@
+#include "mapChunks.hpp"
+#include "drawPixels.hpp"
+#include "profiler.hpp"
+#include "resourceHandler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static bool isGrass(Tile tile) {
+    return tile == Tile::Grass || tile == Tile::GrassFlowers ||
+           tile == Tile::GrassUpperEdge || tile == Tile::GrassLowerEdge ||
+           tile == Tile::_UNUSED1_;
+}
+
+// Sets bits 1, 2, 4 and 8 for grass above, right, below and left of each grass
+// tile, which picks the tile's frame out of the grass sets. Grass edges don't
+// count as neighbours sideways.
+static void computeGrassMask(const TileMap & map, Grid<uint8_t> & mask) {
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+    mask.resize(width, height, 0);
+    const auto grassAt = [&map](int x, int y) {
+        return static_cast<int>(isGrass(map.get(x, y)));
+    };
+    for (int i = 0; i < width; i++) {
+        for (int j = 0; j < height; j++) {
+            if (!isGrass(map(i, j))) {
+                continue;
+            }
+            mask(i, j) += 1 * grassAt(i, j - 1);
+            if (map.get(i + 1, j) != Tile::GrassLowerEdge &&
+                map.get(i + 1, j) != Tile::GrassUpperEdge) {
+                mask(i, j) += 2 * grassAt(i + 1, j);
+            }
+            mask(i, j) += 4 * grassAt(i, j + 1);
+            if (map.get(i - 1, j) != Tile::GrassUpperEdge &&
+                map.get(i - 1, j) != Tile::GrassLowerEdge) {
+                mask(i, j) += 8 * grassAt(i - 1, j);
+            }
+        }
+    }
+}
+
+MapChunks::MapChunks() : columns(0), rows(0), workers(1) {}
+
+MapChunks::Prepared MapChunks::prepare(const LevelLayout & layout) {
+    auto art = std::make_shared<Art>();
+    art->map = layout.map;
+    art->grates = layout.grates;
+    art->variants = layout.variants;
+    computeGrassMask(art->map, art->grassMask);
+    art->tileset =
+        &getgResHandlerPtr()->getImage(ResHandler::Image::soilTileset);
+    art->grassSet =
+        &getgResHandlerPtr()->getImage(ResHandler::Image::grassSet1);
+    art->grassSetEdge =
+        &getgResHandlerPtr()->getImage(ResHandler::Image::grassSet2);
+    Prepared prepared;
+    // The camera starts out over the spawn point, the chunk under it and its
+    // neighbours cover the first frame
+    const int spawnX = layout.spawn.x / size;
+    const int spawnY = layout.spawn.y / size;
+    const int columns = (art->map.getWidth() + size - 1) / size;
+    const int rows = (art->map.getHeight() + size - 1) / size;
+    const int right = std::min(spawnX + 1, columns - 1);
+    const int bottom = std::min(spawnY + 1, rows - 1);
+    for (int x = std::max(spawnX - 1, 0); x <= right; x++) {
+        for (int y = std::max(spawnY - 1, 0); y <= bottom; y++) {
+            prepared.chunks.emplace_back(key(x, y), bake(*art, x, y));
+        }
+    }
+    prepared.art = std::move(art);
+    return prepared;
+}
+
+void MapChunks::reset(Prepared && prepared) {
+    clear();
+    art = std::move(prepared.art);
+    columns = (art->map.getWidth() + size - 1) / size;
+    rows = (art->map.getHeight() + size - 1) / size;
+    for (auto & chunk : prepared.chunks) {
+        upload(keyX(chunk.first), keyY(chunk.first), std::move(chunk.second));
+    }
+}
+
+void MapChunks::clear() {
+    // Jobs already running hold their own reference to the art, abandoning
+    // their futures is enough
+    pending.clear();
+    resident.clear();
+    art.reset();
+    columns = 0;
+    rows = 0;
+}
+
+MapChunks::Range MapChunks::getRange(const sf::View & view,
+                                     const sf::Vector2f & origin,
+                                     int margin) const {
+    const sf::Vector2f corner =
+        view.getCenter() - view.getSize() / 2.f - origin;
+    const sf::Vector2f & extent = view.getSize();
+    Range range;
+    range.left = std::floor(corner.x / pixelWidth) - margin;
+    range.top = std::floor(corner.y / pixelHeight) - margin;
+    range.right = std::floor((corner.x + extent.x) / pixelWidth) + margin;
+    range.bottom = std::floor((corner.y + extent.y) / pixelHeight) + margin;
+    range.left = std::max(range.left, 0);
+    range.top = std::max(range.top, 0);
+    range.right = std::min(range.right, columns - 1);
+    range.bottom = std::min(range.bottom, rows - 1);
+    return range;
+}
+
+MapChunks::Baked MapChunks::bake(const Art & art, int cx, int cy) {
+    Baked baked;
+    baked.floor.create(pixelWidth, pixelHeight, sf::Color::Transparent);
+    baked.edges.create(pixelWidth, pixelHeight, sf::Color::Transparent);
+    const int left = std::max(cx * size, mapImageMargin);
+    const int top = std::max(cy * size, mapImageMargin);
+    const int right = std::min((cx + 1) * size,
+                               art.map.getWidth() - mapImageMargin - 1);
+    const int bottom = std::min((cy + 1) * size,
+                                art.map.getHeight() - mapImageMargin - 1);
+    for (int i = left; i < right; i++) {
+        for (int j = top; j < bottom; j++) {
+            // Position within the chunk's images
+            const int x = i - cx * size;
+            const int y = j - cy * size;
+            const int select = art.variants(i, j);
+            const int frame = art.grassMask(i, j) * 32;
+            switch (art.map(i, j)) {
+            case Tile::Plate:
+                if (art.grates(i, j) != 1) {
+                    drawPixels(baked.floor, *art.tileset, x, y, 0, 0);
+                } else {
+                    drawPixels(baked.floor, *art.tileset, x, y, 256, 0);
+                }
+                break;
+
+            case Tile::Sand:
+                drawPixels(baked.floor, *art.tileset, x, y, 32, 0);
+                break;
+
+            case Tile::SandAndGrass:
+                drawPixels(baked.floor, *art.tileset, x, y, 64, 0);
+                break;
+
+            case Tile::PlateLowerEdge:
+                if (select == 2) {
+                    drawPixels(baked.edges, *art.tileset, x, y, 96, 0);
+                } else if (select == 1) {
+                    drawPixels(baked.edges, *art.tileset, x, y, 288, 0);
+                } else {
+                    drawPixels(baked.edges, *art.tileset, x, y, 320, 0);
+                }
+                break;
+
+            case Tile::PlateUpperEdge:
+                drawPixels(baked.floor, *art.tileset, x, y, 128, 0);
+                break;
+
+            case Tile::Grass:
+                drawPixels(baked.floor, *art.tileset, x, y, 0, 0);
+                if (select != 2) {
+                    drawPixels(baked.floor, *art.grassSetEdge, x, y, frame, 0);
+                } else {
+                    drawPixels(baked.floor, *art.grassSet, x, y, frame, 0);
+                }
+                break;
+
+            case Tile::GrassFlowers:
+                drawPixels(baked.floor, *art.tileset, x, y, 32, 0);
+                if (select != 2) {
+                    drawPixels(baked.floor, *art.grassSetEdge, x, y, frame, 0);
+                } else {
+                    drawPixels(baked.floor, *art.grassSet, x, y, frame, 0);
+                }
+                break;
+
+            case Tile::GrassLowerEdge:
+                if (select != 2) {
+                    drawPixels(baked.edges, *art.tileset, x, y, 192, 0);
+                } else {
+                    drawPixels(baked.edges, *art.tileset, x, y, 160, 0);
+                }
+                break;
+
+            case Tile::GrassUpperEdge:
+                drawPixels(baked.floor, *art.tileset, x, y, 224, 0);
+                break;
+
+            case Tile::Grate:
+                drawPixels(baked.floor, *art.tileset, x, y, 256, 0);
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+    return baked;
+}
+
+void MapChunks::upload(int x, int y, Baked && baked) {
+    Chunk & chunk = resident[key(x, y)];
+    chunk.x = x;
+    chunk.y = y;
+    chunk.floor.loadFromImage(baked.floor);
+    chunk.edges.loadFromImage(baked.edges);
+}
+
+void MapChunks::stream(const sf::View & view, const sf::Vector2f & origin) {
+    if (!art) {
+        return;
+    }
+    const Range visible = getRange(view, origin, 0);
+    const Range wanted = getRange(view, origin, 1);
+    const Range kept = getRange(view, origin, 2);
+    // The kept range is wider than the wanted one, so that a chunk on the
+    // border isn't baked over and over while the camera shakes around it
+    for (auto it = resident.begin(); it != resident.end();) {
+        if (!kept.contains(it->second.x, it->second.y)) {
+            it = resident.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (!kept.contains(keyX(it->first), keyY(it->first))) {
+            it = pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (int x = wanted.left; x <= wanted.right; x++) {
+        for (int y = wanted.top; y <= wanted.bottom; y++) {
+            const uint64_t k = key(x, y);
+            if (resident.count(k) || pending.count(k)) {
+                continue;
+            }
+            std::shared_ptr<const Art> source = art;
+            pending[k] =
+                workers.submit([source, x, y] { return bake(*source, x, y); });
+        }
+    }
+    for (auto it = pending.begin(); it != pending.end();) {
+        const int x = keyX(it->first);
+        const int y = keyY(it->first);
+        const bool ready = it->second.wait_for(std::chrono::seconds(0)) ==
+                           std::future_status::ready;
+        if (ready || visible.contains(x, y)) {
+            upload(x, y, it->second.get());
+            it = pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MapChunks::drawFloor(sf::RenderTarget & target,
+                          const sf::Vector2f & origin) const {
+    profiler::count(profiler::Counter::drawCalls, resident.size());
+    profiler::count(profiler::Counter::sprites, resident.size());
+    for (const auto & element : resident) {
+        const Chunk & chunk = element.second;
+        sf::Sprite sprite(chunk.floor);
+        sprite.setPosition(origin.x + chunk.x * pixelWidth,
+                           origin.y + chunk.y * pixelHeight);
+        target.draw(sprite);
+    }
+}
+
+void MapChunks::drawEdges(sf::RenderTarget & target,
+                          const sf::Vector2f & origin) const {
+    profiler::count(profiler::Counter::drawCalls, resident.size());
+    profiler::count(profiler::Counter::sprites, resident.size());
+    for (const auto & element : resident) {
+        const Chunk & chunk = element.second;
+        sf::Sprite sprite(chunk.edges);
+        sprite.setPosition(origin.x + chunk.x * pixelWidth,
+                           origin.y + chunk.y * pixelHeight);
+        target.draw(sprite);
+    }
+}
+
+size_t MapChunks::getResidentCount() const { return resident.size(); }
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "framework/workerPool.hpp"
+#include "levelGenerator.hpp"
+#include <SFML/Graphics.hpp>
+#include <future>
+#include <memory>
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// The map is drawn in square chunks of tiles, each baked into a floor and an
+// edge texture of its own. Chunks are baked on worker threads as the camera
+// approaches them, and thrown away once it has moved far enough, so only the
+// chunks around the view ever hold textures, however big the level is.
+class MapChunks {
+public:
+    // Tiles per side of a chunk
+    static const int size = 16;
+    static const int pixelWidth = size * 32;
+    static const int pixelHeight = size * 26;
+    // Everything a worker needs to bake any chunk of a level
+    struct Art {
+        TileMap map;
+        Grid<uint8_t> grates;
+        Grid<uint8_t> variants;
+        // Which neighbours of a grass tile are grass too
+        Grid<uint8_t> grassMask;
+        const sf::Image * tileset;
+        const sf::Image * grassSet;
+        const sf::Image * grassSetEdge;
+    };
+    struct Baked {
+        sf::Image floor;
+        sf::Image edges;
+    };
+    // A level's art, with the chunks around the spawn point already baked.
+    // Making one doesn't touch OpenGL, so it can be done on any thread.
+    struct Prepared {
+        std::shared_ptr<const Art> art;
+        std::vector<std::pair<uint64_t, Baked>> chunks;
+    };
+    static Prepared prepare(const LevelLayout & layout);
+    MapChunks();
+    MapChunks(const MapChunks &) = delete;
+    MapChunks & operator=(const MapChunks &) = delete;
+    // Starts over with a new level's map, dropping every baked chunk
+    void reset(Prepared && prepared);
+    void clear();
+    // Uploads the chunks that finished baking, requests the ones coming into
+    // range, and drops the ones that went out of range. Chunks under the view
+    // are waited for, so that there are never holes in the map. origin is the
+    // position of the map's top left corner. Call from the drawing thread.
+    void stream(const sf::View & view, const sf::Vector2f & origin);
+    void drawFloor(sf::RenderTarget & target,
+                   const sf::Vector2f & origin) const;
+    void drawEdges(sf::RenderTarget & target,
+                   const sf::Vector2f & origin) const;
+    size_t getResidentCount() const;
+
+    static uint64_t key(int x, int y) {
+        return (uint64_t(uint32_t(x)) << 32) | uint32_t(y);
+    }
+    static int keyX(uint64_t key) { return static_cast<int32_t>(key >> 32); }
+    static int keyY(uint64_t key) { return static_cast<int32_t>(key); }
+
+private:
+    struct Chunk {
+        int x, y;
+        sf::Texture floor;
+        sf::Texture edges;
+    };
+    struct Range {
+        int left, top, right, bottom;
+        bool contains(int x, int y) const {
+            return x >= left && x <= right && y >= top && y <= bottom;
+        }
+    };
+    Range getRange(const sf::View & view, const sf::Vector2f & origin,
+                   int margin) const;
+    static Baked bake(const Art & art, int x, int y);
+    void upload(int x, int y, Baked && baked);
+    std::shared_ptr<const Art> art;
+    int columns, rows;
+    std::unordered_map<uint64_t, Chunk> resident;
+    std::unordered_map<uint64_t, std::future<Baked>> pending;
+    WorkerPool workers;
+};
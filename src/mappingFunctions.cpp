@@ -1,241 +1,252 @@
 #include "mappingFunctions.hpp"
-#include "tileController.hpp"
-#include <cstring>
-
-static void floodFill(Tile map[MAP_WIDTH][MAP_HEIGHT], size_t x, size_t y, Tile sub) {
-    using Coord = std::pair<size_t, size_t>;
-    std::stack<Coord> stack;
-    stack.push({x, y});
-    Tile target = map[x][y];
-    const auto action = [map, target, sub, &stack](Coord & c, int xOff,
-                                                   int yOff) {
-        const int i = c.first + xOff;
-        const int j = c.second + yOff;
-        if (i > 0 && i < MAP_WIDTH - 1 && j > 0 && j < MAP_HEIGHT - 1) {
-            if (map[i][j] == target) {
-                map[i][j] = sub;
-                stack.push({i, j});
+#include "rng.hpp"
+#include <array>
+#include <bitset>
+#include <stdint.h>
+
+// The cellular automaton and flood fill steps work on bit masks, one 64 bit
+// word per column of the map, with bit j of a column standing for the tile at
+// row j. A shift by one then moves a whole column up or down a row, and bit
+// sliced adders count the neighbours of every cell in a column at once.
+using ColumnMasks = std::array<uint64_t, MAP_WIDTH>;
+
+static const uint64_t columnBits = (uint64_t(1) << MAP_HEIGHT) - 1;
+
+// condense() leaves a two tile border around the map as is
+static const uint64_t condensedRows =
+    columnBits & ~uint64_t(3) & ~(uint64_t(3) << (MAP_HEIGHT - 2));
+
+static uint64_t rowBit(int j) { return uint64_t(1) << j; }
+
+static int countBits(uint64_t mask) {
+    return static_cast<int>(std::bitset<64>(mask).count());
+}
+
+static void fullAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t & sum,
+                    uint64_t & carry) {
+    const uint64_t partial = a ^ b;
+    sum = partial ^ c;
+    carry = (a & b) | (partial & c);
+}
+
+static void randomFill(ColumnMasks & walls, rng::Generator & generator) {
+    walls.fill(0);
+    for (int i = MAP_MARGIN; i < MAP_WIDTH - MAP_MARGIN; i++) {
+        for (int j = MAP_MARGIN; j < MAP_HEIGHT - MAP_MARGIN; j++) {
+            if (rng::random<2>(generator)) {
+                walls[i] |= rowBit(j);
             }
         }
-    };
-    while (!stack.empty()) {
-        Coord coord = stack.top();
-        stack.pop();
-        action(coord, -1, 0);
-        action(coord, 0, 1);
-        action(coord, 0, -1);
-        action(coord, 1, 0);
     }
 }
 
-inline void renumber(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
-    for (int i = 0; i < MAP_WIDTH; i++) {
-        for (int j = 0; j < MAP_HEIGHT; j++) {
-            if (map[i][j] == Tile::Wall) {
-                map[i][j] = Tile::_UNUSED1_;
-            } else if (map[i][j] == Tile::Empty) {
-                map[i][j] = Tile::Wall;
-            }
+// A wall with fewer than two wall neighbours erodes, and an empty tile with
+// more than five fills in.
+static void condense(ColumnMasks & walls, int iterations) {
+    ColumnMasks next = walls;
+    while (iterations-- > 0) {
+        for (int i = 2; i < MAP_WIDTH - 2; i++) {
+            const uint64_t left = walls[i - 1];
+            const uint64_t centre = walls[i];
+            const uint64_t right = walls[i + 1];
+            // Sum the eight neighbours into a four bit count per row
+            uint64_t sumA, carryA, sumB, carryB, sumC, carryC;
+            fullAdd(left << 1, left, left >> 1, sumA, carryA);
+            fullAdd(right << 1, right, right >> 1, sumB, carryB);
+            sumC = (centre << 1) ^ (centre >> 1);
+            carryC = (centre << 1) & (centre >> 1);
+            // The ones bit of the count doesn't matter for the thresholds
+            // below, only the carry out of it does
+            const uint64_t carryD = (sumA & sumB) | (sumC & (sumA ^ sumB));
+            uint64_t twosPartial, foursA;
+            fullAdd(carryA, carryB, carryC, twosPartial, foursA);
+            const uint64_t twos = twosPartial ^ carryD;
+            const uint64_t foursB = twosPartial & carryD;
+            const uint64_t fours = foursA ^ foursB;
+            const uint64_t eights = foursA & foursB;
+            const uint64_t atLeastTwo = twos | fours | eights;
+            const uint64_t atLeastSix = eights | (fours & twos);
+            const uint64_t condensed =
+                (centre & atLeastTwo) | (~centre & atLeastSix);
+            next[i] = (centre & ~condensedRows) | (condensed & condensedRows);
         }
+        walls = next;
     }
 }
 
-inline void addEdges(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
-    for (int i = 0; i < MAP_WIDTH; i++) {
-        for (int j = 0; j < MAP_HEIGHT; j++) {
-            if (map[i][j] == Tile::Wall) {
-                if (map[i][j - 1] == Tile::Plate) {
-                    if (map[i][j + 1] != Tile::Plate) {
-                        map[i][j] = Tile::PlateLowerEdge;
-                    } else {
-                        map[i][j] = Tile::Plate;
-                    }
-                } else if (map[i][j + 1] == Tile::Plate) {
-                    map[i][j] = Tile::PlateUpperEdge;
-                }
-            }
-        }
+// Fills the four-connected part of region containing (x, y). The seed itself
+// is only filled once one of its neighbours is, so an isolated seed fills
+// nothing.
+static ColumnMasks floodFill(const ColumnMasks & region, int x, int y) {
+    ColumnMasks filled{};
+    const uint64_t seed = rowBit(y);
+    const bool hasNeighbour = (region[x - 1] & seed) ||
+                              (region[x + 1] & seed) ||
+                              (region[x] & ((seed << 1) | (seed >> 1)));
+    if (!hasNeighbour) {
+        return filled;
     }
+    filled[x] = seed;
+    const auto spread = [&region, &filled](int i) {
+        uint64_t reached = filled[i];
+        if (i > 0) {
+            reached |= filled[i - 1];
+        }
+        if (i < MAP_WIDTH - 1) {
+            reached |= filled[i + 1];
+        }
+        reached &= region[i];
+        uint64_t previous;
+        do {
+            previous = reached;
+            reached |= ((reached << 1) | (reached >> 1)) & region[i];
+        } while (reached != previous);
+        const bool changed = reached != filled[i];
+        filled[i] = reached;
+        return changed;
+    };
+    bool changed;
+    do {
+        changed = false;
+        for (int i = 0; i < MAP_WIDTH; i++) {
+            changed |= spread(i);
+        }
+        for (int i = MAP_WIDTH - 1; i >= 0; i--) {
+            changed |= spread(i);
+        }
+    } while (changed);
+    return filled;
+}
+
+static void pickWall(const ColumnMasks & walls, rng::Generator & generator,
+                     int & x, int & y) {
+    do {
+        x = rng::random<MAP_WIDTH>(generator);
+        y = rng::random<MAP_HEIGHT>(generator);
+    } while (!(walls[x] & rowBit(y)));
 }
 
-inline void addCenterTiles(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+// Everything besides the plates is wall at this point. Walls directly below
+// a plate become its lower edge, and walls directly above its upper edge.
+static void writePlates(TileMap & map, const ColumnMasks & plates) {
     for (int i = 0; i < MAP_WIDTH; i++) {
+        const uint64_t plate = plates[i];
+        const uint64_t wall = ~plate & columnBits;
+        const uint64_t plateAbove = plate << 1;
+        const uint64_t plateBelow = plate >> 1;
+        const uint64_t solid = plate | (wall & plateAbove & plateBelow);
+        const uint64_t lowerEdge = wall & plateAbove & ~plateBelow;
+        const uint64_t upperEdge = wall & ~plateAbove & plateBelow;
         for (int j = 0; j < MAP_HEIGHT; j++) {
-            if ((map[i - 1][j] == Tile::Plate || map[i - 1][j] == Tile::Sand ||
-                 map[i - 1][j] == Tile::SandAndGrass) &&
-                (map[i + 1][j] == Tile::Plate || map[i + 1][j] == Tile::Sand ||
-                 map[i + 1][j] == Tile::SandAndGrass) &&
-                (map[i][j - 1] == Tile::Plate || map[i][j - 1] == Tile::Sand ||
-                 map[i][j - 1] == Tile::SandAndGrass) &&
-                (map[i][j + 1] == Tile::Plate || map[i][j + 1] == Tile::Sand ||
-                 map[i][j + 1] == Tile::SandAndGrass)) {
-                if (rng::random<12>() > 2) {
-                    map[i][j] = Tile::Sand;
-                } else {
-                    map[i][j] = Tile::SandAndGrass;
-                }
+            const uint64_t bit = rowBit(j);
+            if (solid & bit) {
+                map(i, j) = Tile::Plate;
+            } else if (lowerEdge & bit) {
+                map(i, j) = Tile::PlateLowerEdge;
+            } else if (upperEdge & bit) {
+                map(i, j) = Tile::PlateUpperEdge;
+            } else {
+                map(i, j) = Tile::Wall;
             }
         }
     }
 }
 
-void condense(Tile map[MAP_WIDTH][MAP_HEIGHT], Tile maptemp[MAP_WIDTH][MAP_HEIGHT], int rep) {
-    for (int i = 2; i < MAP_WIDTH - 2; i++) {
-        for (int j = 2; j < MAP_HEIGHT - 2; j++) {
-            uint8_t count = 0;
-            if (map[i - 1][j - 1] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i + 1][j - 1] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i - 1][j + 1] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i + 1][j + 1] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i - 1][j] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i + 1][j] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i][j - 1] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i][j + 1] == Tile::Wall) {
-                count += 1;
-            }
-            if (map[i][j] == Tile::Wall) {
-                if (count < 2) {
-                    maptemp[i][j] = Tile::Empty;
-                } else {
-                    maptemp[i][j] = Tile::Wall;
-                }
-            } else {
-                if (count > 5) {
-                    maptemp[i][j] = Tile::Wall;
+static void addCenterTiles(TileMap & map, rng::Generator & generator) {
+    const auto isFloor = [](Tile t) {
+        return t == Tile::Plate || t == Tile::Sand || t == Tile::SandAndGrass;
+    };
+    // The outermost tiles are always walls, and never get a center tile
+    for (int i = 1; i < MAP_WIDTH - 1; i++) {
+        for (int j = 1; j < MAP_HEIGHT - 1; j++) {
+            if (isFloor(map(i - 1, j)) && isFloor(map(i + 1, j)) &&
+                isFloor(map(i, j - 1)) && isFloor(map(i, j + 1))) {
+                if (rng::random<12>(generator) > 2) {
+                    map(i, j) = Tile::Sand;
                 } else {
-                    maptemp[i][j] = Tile::Empty;
+                    map(i, j) = Tile::SandAndGrass;
                 }
             }
         }
     }
-    for (int i = 2; i < MAP_WIDTH - 2; i++) {
-        for (int j = 2; j < MAP_HEIGHT - 2; j++) {
-            map[i][j] = maptemp[i][j];
-        }
-    }
-    if (rep > 0) {
-        condense(map, maptemp, rep - 1);
-    }
 }
 
-int initMapOverlay(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
-    Tile maptemp[61][61];
-    std::memset(map, 0, sizeof(map[0][0]) * std::pow(61, 2));
-    std::memset(maptemp, 0, sizeof(map[0][0]) * std::pow(61, 2));
-    for (int i = MAP_MARGIN; i < MAP_WIDTH - MAP_MARGIN; i++) {
-        for (int j = MAP_MARGIN; j < MAP_WIDTH - MAP_MARGIN; j++) {
-            map[i][j] = static_cast<Tile>(rng::random<2>());
-        }
-    }
-    condense(map, maptemp, 3);
-    uint8_t xindex;
-    uint8_t yindex;
-    do {
-        xindex = rng::random<MAP_WIDTH>();
-        yindex = rng::random<MAP_HEIGHT>();
-    } while (map[xindex][yindex] != Tile::Wall);
-    floodFill(map, xindex, yindex, Tile::Plate);
+static int initMapOverlay(ColumnMasks & plates, rng::Generator & generator) {
+    ColumnMasks walls;
+    randomFill(walls, generator);
+    condense(walls, 4);
+    int x, y;
+    pickWall(walls, generator, x, y);
+    plates = floodFill(walls, x, y);
     int count = 0;
-    for (int i = 0; i < MAP_WIDTH - 2; i++) {
-        for (int j = 0; j < MAP_HEIGHT - 2; j++) {
-            if (map[i][j] == Tile::Plate) {
-                count += 1;
-            }
-        }
+    for (uint64_t column : plates) {
+        count += countBits(column);
     }
     return count;
 }
 
-void combine(Tile map[MAP_WIDTH][MAP_HEIGHT], Tile overlay[MAP_WIDTH][MAP_HEIGHT]) {
+static void combine(TileMap & map, const ColumnMasks & overlay) {
     for (int i = 0; i < MAP_WIDTH; i++) {
         for (int j = 0; j < MAP_HEIGHT; j++) {
-            if ((overlay[i][j] == Tile::Plate && map[i][j] != Tile::Empty) &&
-                (overlay[i][j] == Tile::Plate && map[i][j] != Tile::Wall)) {
-                if (map[i][j] == Tile::PlateLowerEdge) {
-                    map[i][j] = Tile::GrassLowerEdge;
-                } else if (map[i][j] == Tile::PlateUpperEdge) {
-                    map[i][j] = Tile::GrassUpperEdge;
-                } else if (map[i][j] == Tile::Plate) {
-                    map[i][j] = Tile::Grass;
+            if ((overlay[i] & rowBit(j)) && map(i, j) != Tile::Empty &&
+                map(i, j) != Tile::Wall) {
+                if (map(i, j) == Tile::PlateLowerEdge) {
+                    map(i, j) = Tile::GrassLowerEdge;
+                } else if (map(i, j) == Tile::PlateUpperEdge) {
+                    map(i, j) = Tile::GrassUpperEdge;
+                } else if (map(i, j) == Tile::Plate) {
+                    map(i, j) = Tile::Grass;
                 } else {
-                    map[i][j] = Tile::GrassFlowers;
+                    map(i, j) = Tile::GrassFlowers;
                 }
             }
         }
     }
 }
 
-void cleanEdgesPostCombine(Tile map[61][61]) {
+static void cleanEdgesPostCombine(TileMap & map) {
     for (int i = 1; i < MAP_WIDTH - 1; i++) {
         for (int j = 1; j < MAP_HEIGHT - 1; j++) {
-            if (map[i][j] == Tile::GrassLowerEdge && map[i][j - 1] != Tile::Grass) {
-                map[i][j] = Tile::PlateLowerEdge;
-            } else if (map[i][j] == Tile::GrassUpperEdge && map[i][j + 1] != Tile::Grass) {
-                map[i][j] = Tile::PlateUpperEdge;
+            if (map(i, j) == Tile::GrassLowerEdge &&
+                map(i, j - 1) != Tile::Grass) {
+                map(i, j) = Tile::PlateLowerEdge;
+            } else if (map(i, j) == Tile::GrassUpperEdge &&
+                       map(i, j + 1) != Tile::Grass) {
+                map(i, j) = Tile::PlateUpperEdge;
             }
         }
     }
 }
 
-int generateMap(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
-    Tile maptemp[MAP_WIDTH][MAP_HEIGHT];
-    std::memset(map, 0, sizeof(map[0][0]) * std::pow(61, 2));
-    std::memset(maptemp, 0, sizeof(maptemp[0][0]) * std::pow(61, 2));
-    for (int i = MAP_MARGIN; i < MAP_WIDTH - MAP_MARGIN; i++) {
-        for (int j = MAP_MARGIN; j < MAP_HEIGHT - MAP_MARGIN; j++) {
-            map[i][j] = static_cast<Tile>(rng::random<2>());
-        }
-    }
-    condense(map, maptemp, 1);
-    renumber(map);
-    uint8_t xindex;
-    uint8_t yindex;
-    do {
-        xindex = rng::random<MAP_WIDTH>();
-        yindex = rng::random<MAP_HEIGHT>();
-    } while (map[xindex][yindex] != Tile::_UNUSED1_);
-    floodFill(map, xindex, yindex, Tile::Plate);
-    for (int i = 2; i < MAP_WIDTH - 2; i++) {
-        for (int j = 2; j < MAP_HEIGHT - 2; j++) {
-            if (map[i][j] == Tile::_UNUSED1_) {
-                map[i][j] = Tile::Wall;
-            }
-        }
-    }
-    addEdges(map); // Adds the top and bottom edges for the platforms
-    addCenterTiles(map);
+int generateMap(TileMap & map, rng::Generator & generator,
+                int & overlayRetries) {
+    map.resize(MAP_WIDTH, MAP_HEIGHT);
+    ColumnMasks walls;
+    randomFill(walls, generator);
+    condense(walls, 2);
+    int x, y;
+    pickWall(walls, generator, x, y);
+    writePlates(map, floodFill(walls, x, y));
+    addCenterTiles(map, generator);
     int count = 0;
     for (int i = 0; i < MAP_WIDTH - 2; i++) {
         for (int j = 0; j < MAP_HEIGHT - 2; j++) {
-            if (map[i][j] == Tile::Sand || map[i][j] == Tile::SandAndGrass) {
+            if (map(i, j) == Tile::Sand || map(i, j) == Tile::SandAndGrass) {
                 count += 1;
             }
-            if (map[i + 1][j] == Tile::Plate && map[i - 1][j] == Tile::Plate &&
-                map[i][j + 1] == Tile::Plate && map[i][j - 1] == Tile::Plate) {
-                map[i][j] = Tile::Plate;
+            if (map(i + 1, j) == Tile::Plate &&
+                map.get(i - 1, j) == Tile::Plate &&
+                map(i, j + 1) == Tile::Plate &&
+                map.get(i, j - 1) == Tile::Plate) {
+                map(i, j) = Tile::Plate;
             }
         }
     }
-    Tile mapOverlay[MAP_WIDTH][MAP_HEIGHT];
-    int count2;
-    do {
-        count2 = initMapOverlay(mapOverlay);
-    } while (count2 < 300);
-    combine(map, mapOverlay);
+    ColumnMasks overlay;
+    while (initMapOverlay(overlay, generator) < 300) {
+        ++overlayRetries;
+    }
+    combine(map, overlay);
     cleanEdgesPostCombine(map);
     return count;
 }
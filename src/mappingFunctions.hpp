@@ -1,12 +1,20 @@
 #pragma once
 
 #include "Tile.hpp"
+#include "rng.hpp"
+#include "tileMap.hpp"
 
+// The size of the maps generateMap() builds. Its cellular automaton packs a
+// column of the map into a 64 bit word, so MAP_HEIGHT can't exceed 64.
 #define MAP_WIDTH 61
 #define MAP_HEIGHT 61
 #define MAP_MARGIN 16
 
-int generateMap(Tile map[MAP_WIDTH][MAP_HEIGHT]);
+// Resizes map to MAP_WIDTH by MAP_HEIGHT and fills it. Returns the number of
+// center tiles, levels need at least 150. Adds the number of rejected
+// attempts at the grass overlay to overlayRetries.
+int generateMap(TileMap & map, rng::Generator & generator,
+                int & overlayRetries);
 
 inline bool isTileWalkable(Tile t) {
     return t == Tile::Sand ||
@@ -14,4 +22,12 @@ inline bool isTileWalkable(Tile t) {
         t == Tile::Plate ||
         t == Tile::Grass ||
         t == Tile::GrassFlowers;
-}
\ No newline at end of file
+}
+
+inline bool isTileWall(Tile t) {
+    return t == Tile::Wall ||
+        t == Tile::PlateLowerEdge ||
+        t == Tile::PlateUpperEdge ||
+        t == Tile::GrassLowerEdge ||
+        t == Tile::GrassUpperEdge;
+}
@@ -0,0 +1,52 @@
+#include "motionTrail.hpp"
+
+// A new segment starts out at about half opacity, and fades away over
+// lifetime
+static const int32_t lifetime = 100000;
+static const uint8_t initialAlpha = 135;
+
+MotionTrail::MotionTrail(const sf::IntRect & firstFrame,
+                         const sf::Vector2f & origin)
+    : begin(0), count(0), firstFrame(firstFrame), origin(origin) {}
+
+void MotionTrail::push(float x, float y, uint8_t frame, bool mirrored) {
+    if (count == capacity) {
+        begin = (begin + 1) % capacity;
+        --count;
+    }
+    segments[(begin + count) % capacity] = {x, y, 0, frame, mirrored};
+    ++count;
+}
+
+void MotionTrail::update(const sf::Time & elapsedTime) {
+    const int32_t micros = elapsedTime.asMicroseconds();
+    for (size_t i = 0; i < count; ++i) {
+        segments[(begin + i) % capacity].age += micros;
+    }
+    while (count && segments[begin].age >= lifetime) {
+        begin = (begin + 1) % capacity;
+        --count;
+    }
+}
+
+void MotionTrail::clear() { count = 0; }
+
+bool MotionTrail::empty() const { return count == 0; }
+
+void MotionTrail::draw(SpriteBatch & batch,
+                       const sf::Texture & texture) const {
+    const float width = firstFrame.width;
+    const float height = firstFrame.height;
+    for (size_t i = 0; i < count; ++i) {
+        const Segment & segment = segments[(begin + i) % capacity];
+        const float scale = segment.mirrored ? -1.f : 1.f;
+        const uint8_t alpha =
+            initialAlpha * (lifetime - segment.age) / lifetime;
+        batch.add(texture,
+                  {segment.x - origin.x * scale, segment.y - origin.y,
+                   width * scale, height},
+                  {firstFrame.left + segment.frame * width,
+                   static_cast<float>(firstFrame.top), width, height},
+                  sf::Color(190, 190, 210, alpha));
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "spriteBatch.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <stdint.h>
+
+// The fading afterimages left behind by something dashing. A segment is
+// only a position, a frame of the owner's sprite sheet and an age, kept in
+// a fixed size ring, so that leaving a trail never allocates. Segments all
+// live for the same time, so they expire oldest first, and once the ring
+// is full a new segment takes the place of the oldest one.
+class MotionTrail {
+public:
+    static const size_t capacity = 8;
+    // firstFrame is the owner's first frame, the rest follow it to the
+    // right. origin is the same as the owner's sprite origin.
+    MotionTrail(const sf::IntRect & firstFrame, const sf::Vector2f & origin);
+    void push(float x, float y, uint8_t frame, bool mirrored = false);
+    void update(const sf::Time &);
+    void clear();
+    bool empty() const;
+    // Adds a quad per segment, colored the way shadeDefault would color it
+    void draw(SpriteBatch &, const sf::Texture &) const;
+
+private:
+    struct Segment {
+        float x, y;
+        int32_t age;
+        uint8_t frame;
+        bool mirrored;
+    };
+    std::array<Segment, capacity> segments;
+    size_t begin, count;
+    sf::IntRect firstFrame;
+    sf::Vector2f origin;
+};
@@ -0,0 +1,133 @@
+#include "particles.hpp"
+#include "easingTemplates.hpp"
+#include "enemyKinematics.hpp"
+#include "resourceHandler.hpp"
+#include "rng.hpp"
+
+namespace {
+struct KindInfo {
+    ResHandler::Texture texture;
+    // The first frame, the rest follow it to the right
+    int left, top, width, height;
+    float originX, originY;
+    uint8_t frameCount;
+    int32_t frameMicros;
+    // Glows are centered on the particle, and fade out from glowPeak
+    bool glow;
+    ResHandler::Texture glowTexture;
+    float (*glowFade)(int64_t, int64_t);
+    int64_t glowMicros;
+};
+}
+
+static const uint8_t glowPeak = 230;
+
+static const std::array<KindInfo,
+                        static_cast<size_t>(ParticleSystem::Kind::Count)>
+    kindInfo{{{ResHandler::Texture::gameObjects, 174, 224, 36, 36, 18.f, 18.f,
+               6, 65000, true, ResHandler::Texture::fireExplosionGlow,
+               Easing::easeOut<2, int64_t>, 300000},
+              {ResHandler::Texture::gameObjects, 208, 173, 58, 51, 29.f, 25.f,
+               9, 70000, true, ResHandler::Texture::fireExplosionGlow,
+               Easing::easeOut<1, int64_t>, 560000},
+              {ResHandler::Texture::gameObjects, 88, 145, 16, 16, 0.f, 0.f, 4,
+               50000, false, ResHandler::Texture::count, nullptr, 0},
+              {ResHandler::Texture::gameObjects, 0, 116, 16, 16, 0.f, 0.f, 5,
+               40000, false, ResHandler::Texture::count, nullptr, 0}}};
+
+static const KindInfo & getInfo(ParticleSystem::Kind kind) {
+    return kindInfo[static_cast<size_t>(kind)];
+}
+
+ParticleSystem::ParticleSystem()
+    : count(0), sprites(capacity), glows(capacity) {}
+
+void ParticleSystem::spawn(Kind kind, float x, float y) {
+    bool flip = false;
+    if (kind == Kind::TurretFlash) {
+        flip = rng::random<2>(rng::Stream::fx);
+        if (flip) {
+            x += 17;
+        }
+    }
+    if (count == capacity) {
+        return;
+    }
+    xs[count] = x;
+    ys[count] = y;
+    timers[count] = 0;
+    glowTimers[count] = 0;
+    kinds[count] = kind;
+    frames[count] = 0;
+    flipped[count] = flip;
+    ++count;
+}
+
+void ParticleSystem::removeAt(size_t index) {
+    --count;
+    xs[index] = xs[count];
+    ys[index] = ys[count];
+    timers[index] = timers[count];
+    glowTimers[index] = glowTimers[count];
+    kinds[index] = kinds[count];
+    frames[index] = frames[count];
+    flipped[index] = flipped[count];
+}
+
+void ParticleSystem::update(const sf::Time & elapsedTime) {
+    const int32_t micros = elapsedTime.asMicroseconds();
+    for (size_t i = 0; i < count; ++i) {
+        timers[i] += micros;
+        glowTimers[i] += micros;
+    }
+    for (size_t i = count; i-- > 0;) {
+        const KindInfo & info = getInfo(kinds[i]);
+        if (timers[i] > info.frameMicros) {
+            timers[i] -= info.frameMicros;
+            if (++frames[i] == info.frameCount) {
+                removeAt(i);
+            }
+        }
+    }
+}
+
+void ParticleSystem::clear() { count = 0; }
+
+size_t ParticleSystem::size() const { return count; }
+
+void ParticleSystem::prepare(const sf::View & view) {
+    sprites.clear();
+    glows.clear();
+    // Wide enough for the largest glow
+    const ViewBounds bounds(view, 256);
+    ResHandler * resources = getgResHandlerPtr();
+    for (size_t i = 0; i < count; ++i) {
+        const float x = xs[i];
+        const float y = ys[i];
+        if (!bounds.contains(x, y)) {
+            continue;
+        }
+        const KindInfo & info = getInfo(kinds[i]);
+        const float scale = flipped[i] ? -1.f : 1.f;
+        sprites.add(resources->getTexture(info.texture),
+                    {x - info.originX * scale, y - info.originY,
+                     info.width * scale, static_cast<float>(info.height)},
+                    sf::FloatRect(info.left + frames[i] * info.width,
+                                  info.top, info.width, info.height),
+                    sf::Color::White);
+        if (info.glow) {
+            const sf::Texture & texture =
+                resources->getTexture(info.glowTexture);
+            const sf::Vector2f size(texture.getSize());
+            const uint8_t brightness =
+                info.glowFade(glowTimers[i], info.glowMicros) * glowPeak;
+            glows.add(texture, {x - size.x / 2, y - size.y / 2, size.x, size.y},
+                      {0.f, 0.f, size.x, size.y},
+                      sf::Color(brightness, brightness, brightness, 255));
+        }
+    }
+}
+
+const SpriteBatch & ParticleSystem::getSprites() const { return sprites; }
+
+const SpriteBatch & ParticleSystem::getGlows() const { return glows; }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "spriteBatch.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <stdint.h>
+
+// Short lived animations that nothing refers to once they're spawned, like
+// explosions and muzzle flashes. They live in fixed size arrays, one per
+// field, so spawning one never allocates and a tick updates them all in
+// one loop. What each kind looks like comes from a table, see particles.cpp.
+// Instead of a sprite each, they're drawn as sprite batches.
+//
+// update() runs on the logic thread and prepare() on the render thread,
+// both under the overworld lock. The layers that prepare() fills are only
+// touched by the render thread.
+class ParticleSystem {
+public:
+    enum class Kind : uint8_t {
+        SmallExplosion,
+        FireExplosion,
+        ShotPuff,
+        TurretFlash,
+        Count
+    };
+    static const size_t capacity = 512;
+    ParticleSystem();
+    // Does nothing if the pool is full
+    void spawn(Kind, float x, float y);
+    void update(const sf::Time &);
+    void clear();
+    size_t size() const;
+    // Fills the layers below from the particles near the view
+    void prepare(const sf::View &);
+    // Drawn unshaded into the lighting map, over the other objects
+    const SpriteBatch & getSprites() const;
+    // Drawn onto the floor, along with the other glows
+    const SpriteBatch & getGlows() const;
+
+private:
+    void removeAt(size_t);
+    size_t count;
+    std::array<float, capacity> xs, ys;
+    std::array<int32_t, capacity> timers, glowTimers;
+    std::array<Kind, capacity> kinds;
+    std::array<uint8_t, capacity> frames, flipped;
+    SpriteBatch sprites, glows;
+};
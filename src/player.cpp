@@ -9,7 +9,8 @@ Player::Player(float _xPos, float _yPos)
                                           // Hmmm why does it work...
       yPos(_yPos), frameIndex(5), sheetIndex(Sheet::stillDown),
       cachedSheet(Sheet::stillDown), lSpeed(0.f), rSpeed(0.f), uSpeed(0.f),
-      dSpeed(0.f), animationTimer(0), dashTimer(0), invulnerable(false),
+      dSpeed(0.f), dashTrail(dashSheet.getFrameRect(0), {0.f, 1.f}),
+      animationTimer(0), dashTimer(0), invulnerable(false),
       state(Player::State::nominal), colorAmount(0.f), colorTimer(0),
       renderType(Rendertype::shadeDefault), upPrevious(false),
       downPrevious(false), leftPrevious(false), rightPrevious(false) {
@@ -168,7 +169,7 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
     bool collisionDown(false);
     bool collisionLeft(false);
     bool collisionRight(false);
-    uint_fast8_t collisionMask = checkCollisionWall(tiles.walls, yPos, xPos);
+    uint_fast8_t collisionMask = checkCollisionWall(tiles, yPos, xPos);
     collisionMask |= checkCollisionChest(
         details.get<DetailRef::TreasureChest>(), yPos, xPos);
     if (collisionMask & 0x01) {
@@ -297,7 +298,7 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
                     std::abs(yPos - chestPosition.y) < 26 &&
                     chest->getState() == TreasureChest::State::closed &&
                     action) {
-                    util::sleep(milliseconds(40));
+                    pGame->getHitStop().start(sf::milliseconds(40));
                     pGame->getSounds().play(ResHandler::Sound::creak, chest,
                                             64.f, 8.f);
                     chest->setState(TreasureChest::State::opening);
@@ -431,9 +432,10 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
     }
     updateColor(elapsedTime);
     if (health > 0 && state != Player::State::deactivated) {
-        checkEffectCollisions(effects, uiFrontend, sounds);
+        checkEffectCollisions(effects, uiFrontend, sounds,
+                              pGame->getHitStop());
         enemyController & enemies = pGame->getEnemyController();
-        checkEnemyCollisions(enemies, uiFrontend, sounds);
+        checkEnemyCollisions(enemies, uiFrontend, sounds, pGame->getHitStop());
     }
     if (health <= 0 && state != Player::State::dead) {
         state = Player::State::dead;
@@ -445,16 +447,7 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
     yPos -= (uSpeed + -dSpeed) *
             (elapsedTime.asMicroseconds() * MOVEMENT_RATE_CONSTANT);
     setPosition(xPos, yPos);
-    if (!blurs.empty()) {
-        for (auto it = blurs.begin(); it != blurs.end();) {
-            if (it->getKillFlag())
-                it = blurs.erase(it);
-            else {
-                it->update(elapsedTime);
-                ++it;
-            }
-        }
-    }
+    dashTrail.update(elapsedTime);
     switch (sheetIndex) {
     case Sheet::stillDown:
         if (gun.timeout > 0) {
@@ -518,7 +511,8 @@ void Player::update(Game * pGame, const sf::Time & elapsedTime,
     }
 }
 
-void Player::draw(drawableVec & gameObjects, drawableVec & gameShadows) {
+void Player::draw(drawableVec & gameObjects, drawableVec & gameShadows,
+                  SpriteBatch & trails) {
     if (visible) {
         auto gunIndexOffset = [](int64_t timeout) {
             if (timeout < 1707000 && timeout > 44000) {
@@ -628,22 +622,18 @@ void Player::draw(drawableVec & gameObjects, drawableVec & gameShadows) {
             if (state == Player::State::dashing) {
                 if (animationTimer > 20000) {
                     animationTimer = 0;
-                    blurs.emplace_back(
-                        &std::get<DetailRef::Teleporter>(gameObjects.back()),
-                        xPos, yPos);
+                    dashTrail.push(xPos, yPos, frameIndex);
                 }
             }
             break;
         }
     }
-    for (auto & element : blurs) {
-        gameObjects.emplace_back(*element.getSprite(), element.yInit,
-                                 Rendertype::shadeDefault, 0.f);
-    }
+    dashTrail.draw(trails, getgResHandlerPtr()->getTexture(
+                               ResHandler::Texture::gameObjects));
 }
 
 template <ResHandler::Sound StepBase, int NumSteps> int getRandomStep() {
-    int choice = rng::random<NumSteps, 0>();
+    int choice = rng::random<NumSteps, 0>(rng::Stream::audio);
     choice += static_cast<int>(StepBase);
     return choice;
 }
@@ -752,7 +742,8 @@ void checkEffectCollision(EffectGroup & effects, Player * pPlayer,
 
 void Player::checkEffectCollisions(EffectGroup & effects,
                                    ui::Frontend & uiFrontend,
-                                   SoundController & sounds) {
+                                   SoundController & sounds,
+                                   HitStop & hitStop) {
     auto hitPolicy = [&]() {
         if (colorAmount == 0.f) {
             health -= 1;
@@ -760,7 +751,7 @@ void Player::checkEffectCollisions(EffectGroup & effects,
             renderType = Rendertype::shadeGldnGt;
             colorAmount = 1.f;
             colorTimer = 0;
-            util::sleep(milliseconds(40));
+            hitStop.start(sf::milliseconds(40));
         }
     };
     checkEffectCollision<EffectRef::EnemyShot>(effects, this, hitPolicy);
@@ -772,14 +763,14 @@ void Player::checkEffectCollisions(EffectGroup & effects,
         renderType = Rendertype::shadeRuby;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        hitStop.start(sf::milliseconds(40));
     });
     checkEffectCollision<EffectRef::Coin>(effects, this, [&]() {
         uiFrontend.updateScore(1);
         renderType = Rendertype::shadeElectric;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        hitStop.start(sf::milliseconds(40));
     });
     checkEffectCollision<EffectRef::GoldHeart>(effects, this, [&] {
         char maxHealth = uiFrontend.getMaxHealth();
@@ -789,7 +780,7 @@ void Player::checkEffectCollisions(EffectGroup & effects,
         renderType = Rendertype::shadeYellow;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        hitStop.start(sf::milliseconds(40));
     });
 }
 
@@ -805,19 +796,20 @@ void checkEnemyCollision(const std::vector<std::shared_ptr<T>> & enemyGroup,
 
 void Player::checkEnemyCollisions(enemyController & enemies,
                                   ui::Frontend & uiFrontend,
-                                  SoundController & sounds) {
+                                  SoundController & sounds,
+                                  HitStop & hitStop) {
     auto collisionPolicy = [&]() {
         health -= 1;
         uiFrontend.updateHealth(health);
         renderType = Rendertype::shadeGldnGt;
         colorAmount = 1.f;
         colorTimer = 0;
-        util::sleep(milliseconds(40));
+        hitStop.start(sf::milliseconds(40));
     };
     checkEnemyCollision(enemies.getCritters(), this, [&] {
         if (colorAmount == 0.f) {
             collisionPolicy();
-            if (rng::random<1>()) {
+            if (rng::random<1>(rng::Stream::audio)) {
                 sounds.play(ResHandler::Sound::bite1);
             } else {
                 sounds.play(ResHandler::Sound::bite2);
@@ -829,8 +821,8 @@ void Player::checkEnemyCollisions(enemyController & enemies,
             collisionPolicy();
         }
     });
-    checkEnemyCollision(enemies.getScoots(), this, [&] {
-        if (colorAmount == 0.f) {
+    enemies.getScoots().forEachHitBox([&](const ScootGroup::HBox & box) {
+        if (hitBox.overlapping(box) && colorAmount == 0.f) {
             collisionPolicy();
         }
     });
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "DetailGroup.hpp"
+#include "hitStop.hpp"
 #include "RenderType.hpp"
 #include "inputController.hpp"
+#include "motionTrail.hpp"
 #include "playerAnimationFunctions.hpp"
 #include "playerCollisionFunctions.hpp"
 #include "resourceHandler.hpp"
@@ -51,7 +53,7 @@ public:
     void activate();
     float getXpos() const; // The player's absolute position in the window
     float getYpos() const;
-    void draw(drawableVec &, drawableVec &);
+    void draw(drawableVec &, drawableVec &, SpriteBatch & trails);
     void update(Game *, const sf::Time &, SoundController &);
     void setState(State);
     State getState() const;
@@ -77,11 +79,9 @@ private:
                    SoundController &, ui::Backend &);
     Weapon gun;
     void checkEffectCollisions(EffectGroup &, ui::Frontend &,
-                               SoundController &);
+                               SoundController &, HitStop &);
     void checkEnemyCollisions(enemyController &, ui::Frontend &,
-                              SoundController &);
-    std::vector<Dasher::Blur> blurs; // TODO: Move blur subclass out of Dasher,
-                                     // and into its own file...
+                              SoundController &, HitStop &);
     Health health;
     void updateAnimation(const sf::Time &, uint8_t, uint32_t,
                          SoundController &);
@@ -96,6 +96,7 @@ private:
     SpriteSheet<432, 76, 32, 32> walkRight;
     SpriteSheet<208, 38, 40, 38> deathSheet;
     SpriteSheet<208, 140, 32, 33> dashSheet;
+    MotionTrail dashTrail;
     int64_t animationTimer, dashTimer;
     bool invulnerable;
     State state;
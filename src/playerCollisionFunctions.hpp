@@ -1,34 +1,32 @@
 #pragma once
 
 #include "DetailGroup.hpp"
-#include "wall.hpp"
+#include "tileController.hpp"
 #include <cmath>
 
-inline uint_fast8_t checkCollisionWall(std::vector<wall> & walls, float posY,
-                                       float posX) {
+inline uint_fast8_t checkCollisionWall(const tileController & tiles,
+                                       float posY, float posX) {
     uint_fast8_t collisionMask = 0;
-    for (auto & wall : walls) {
-        if ((posX + 6 < (wall.getPosX() + wall.getWidth()) &&
-             (posX + 6 > (wall.getPosX()))) &&
-            (fabs((posY + 16) - wall.getPosY()) <= 13)) {
+    // Walls outside of this box can't pass any of the tests below
+    const sf::FloatRect area(posX - 26, posY - 4, 50, 40);
+    tiles.forEachWallIn(area, [&](const sf::Vector2f & wall) {
+        if ((posX + 6 < (wall.x + 32) && (posX + 6 > (wall.x))) &&
+            (fabs((posY + 16) - wall.y) <= 13)) {
             collisionMask |= 0x01;
         }
-        if ((posX + 24 > (wall.getPosX()) &&
-             (posX + 24 < (wall.getPosX() + wall.getWidth()))) &&
-            (fabs((posY + 16) - wall.getPosY()) <= 13)) {
+        if ((posX + 24 > (wall.x) && (posX + 24 < (wall.x + 32))) &&
+            (fabs((posY + 16) - wall.y) <= 13)) {
             collisionMask |= 0x02;
         }
-        if (((posY + 22 < (wall.getPosY() + wall.getHeight())) &&
-             (posY + 22 > (wall.getPosY()))) &&
-            (fabs((posX)-wall.getPosX()) <= 16)) {
+        if (((posY + 22 < (wall.y + 26)) && (posY + 22 > (wall.y))) &&
+            (fabs((posX)-wall.x) <= 16)) {
             collisionMask |= 0x04;
         }
-        if (((posY + 36 > wall.getPosY()) &&
-             (posY + 36 < wall.getPosY() + wall.getHeight())) &&
-            (fabs((posX)-wall.getPosX()) <= 16)) {
+        if (((posY + 36 > wall.y) && (posY + 36 < wall.y + 26)) &&
+            (fabs((posX)-wall.x) <= 16)) {
             collisionMask |= 0x08;
         }
-    }
+    });
     return collisionMask;
 }
 
@@ -0,0 +1,171 @@
+#include "profiler.hpp"
+#include "resourceHandler.hpp"
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace profiler {
+namespace detail {
+std::atomic<bool> enabled(false);
+std::array<std::atomic<uint64_t>, static_cast<int>(Counter::count)> counters;
+
+struct StageTotals {
+    std::atomic<uint64_t> nanos{0};
+    std::atomic<uint64_t> count{0};
+};
+
+static std::array<StageTotals, static_cast<int>(Stage::count)> totals;
+
+struct TraceEvent {
+    Stage stage;
+    Clock::time_point begin;
+    Clock::time_point end;
+};
+
+// A few minutes of play, events past that are dropped
+static const size_t maxTraceEvents = 1 << 20;
+static std::atomic<bool> tracing(false);
+static std::mutex traceMutex;
+static std::vector<TraceEvent> traceEvents;
+static Clock::time_point traceStart;
+
+void record(Stage stage, Clock::time_point begin, Clock::time_point end) {
+    auto & stageTotals = totals[static_cast<int>(stage)];
+    const auto nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
+    // Each stage is only timed by one thread, relaxed is enough
+    stageTotals.nanos.fetch_add(nanos.count(), std::memory_order_relaxed);
+    stageTotals.count.fetch_add(1, std::memory_order_relaxed);
+    if (tracing.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lk(traceMutex);
+        if (traceEvents.size() < maxTraceEvents) {
+            traceEvents.push_back({stage, begin, end});
+        }
+    }
+}
+}
+
+static const char * stageNames[] = {
+    "tiles",       "details",     "enemies",     "camera",
+    "player",      "effects",     "visibility",  "ui",
+    "background",  "tiles.draw",  "objects",     "face sort",
+    "lightingMap", "post process", "ui",         "transitions"};
+
+static_assert(sizeof(stageNames) / sizeof(stageNames[0]) ==
+                  static_cast<int>(Stage::count),
+              "every stage needs a name");
+
+static bool isLogicStage(Stage stage) { return stage < Stage::drawBackground; }
+
+uint64_t takeCount(Counter counter) {
+    return detail::counters[static_cast<int>(counter)].exchange(0);
+}
+
+void setEnabled(bool enabled) {
+    detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void startTrace() {
+    std::lock_guard<std::mutex> lk(detail::traceMutex);
+    detail::traceEvents.clear();
+    detail::traceStart = Clock::now();
+    detail::tracing = true;
+    setEnabled(true);
+}
+
+bool isTracing() { return detail::tracing; }
+
+void stopTrace(const std::string & path) {
+    std::vector<detail::TraceEvent> events;
+    Clock::time_point start;
+    {
+        std::lock_guard<std::mutex> lk(detail::traceMutex);
+        detail::tracing = false;
+        events.swap(detail::traceEvents);
+        start = detail::traceStart;
+    }
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("profiler: unable to create " + path);
+    }
+    const auto micros = [start](Clock::time_point t) {
+        return std::chrono::duration<double, std::micro>(t - start).count();
+    };
+    // Complete ("X") events, one track per thread
+    file << "{\"traceEvents\":[\n"
+         << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,"
+         << "\"args\":{\"name\":\"main\"}},\n"
+         << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,"
+         << "\"args\":{\"name\":\"logic\"}}";
+    char buffer[192];
+    for (const auto & event : events) {
+        const bool logic = isLogicStage(event.stage);
+        std::snprintf(buffer, sizeof(buffer),
+                      ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+                      "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d}",
+                      stageNames[static_cast<int>(event.stage)],
+                      logic ? "logic" : "graphics", micros(event.begin),
+                      micros(event.end) - micros(event.begin), logic ? 1 : 0);
+        file << buffer;
+    }
+    file << "\n]}\n";
+    if (!file) {
+        throw std::runtime_error("profiler: error writing " + path);
+    }
+}
+
+Overlay::Overlay() : lastTotals{}, lastCounts{} {
+    text.setFont(getgResHandlerPtr()->getFont(ResHandler::Font::cornerstone));
+    text.setCharacterSize(14);
+    text.setFillColor(sf::Color::White);
+    text.setPosition(12, 8);
+    background.setFillColor(sf::Color(0, 0, 0, 160));
+    background.setPosition(4, 4);
+}
+
+void Overlay::update(const std::string & status) {
+    static const std::chrono::milliseconds refreshInterval(500);
+    const auto now = Clock::now();
+    if (now - lastRefresh < refreshInterval) {
+        return;
+    }
+    lastRefresh = now;
+    std::string table;
+    char line[64];
+    for (int i = 0; i < static_cast<int>(Stage::count); ++i) {
+        const auto stage = static_cast<Stage>(i);
+        if (stage == Stage::logicTiles) {
+            table += "logic (us)\n";
+        } else if (stage == Stage::drawBackground) {
+            table += "graphics (us)\n";
+        }
+        const uint64_t total = detail::totals[i].nanos.load();
+        const uint64_t count = detail::totals[i].count.load();
+        const uint64_t samples = count - lastCounts[i];
+        const double average =
+            samples ? (total - lastTotals[i]) / 1000.0 / samples : 0.0;
+        lastTotals[i] = total;
+        lastCounts[i] = count;
+        std::snprintf(line, sizeof(line), "  %-14s %8.1f\n", stageNames[i],
+                      average);
+        table += line;
+    }
+    table += status + "\n";
+    if (isTracing()) {
+        table += "recording trace\n";
+    }
+    text.setString(table);
+    const sf::FloatRect bounds = text.getLocalBounds();
+    background.setSize({bounds.width + 24, bounds.height + 20});
+}
+
+void Overlay::draw(sf::RenderTarget & target) {
+    const sf::View previousView = target.getView();
+    target.setView(target.getDefaultView());
+    target.draw(background);
+    target.draw(text);
+    target.setView(previousView);
+}
+}
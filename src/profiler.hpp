@@ -0,0 +1,110 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <string>
+
+// Scoped timers around the stages of the logic and graphics updates. While
+// the profiler is disabled, a timer costs a relaxed atomic load and a branch.
+// Once enabled, each stage keeps a running total that the overlay turns into
+// per frame averages, and while a trace is being recorded, every timer is
+// also logged for export as Chrome trace JSON (chrome://tracing, Perfetto).
+namespace profiler {
+enum class Stage {
+    // Game::updateLogic(), on the logic thread
+    logicTiles,
+    logicDetails,
+    logicEnemies,
+    logicCamera,
+    logicPlayer,
+    logicEffects,
+    logicVisibility,
+    logicUI,
+    // Game::updateGraphics(), on the main thread
+    drawBackground,
+    drawTiles,
+    drawObjects,
+    drawFaceSort,
+    drawLighting,
+    drawPostProcess,
+    drawUI,
+    drawTransitions,
+    count
+};
+
+// Tallies kept alongside the timers, e.g. how many sprites a frame drew
+enum class Counter { drawCalls, sprites, count };
+
+using Clock = std::chrono::steady_clock;
+
+namespace detail {
+extern std::atomic<bool> enabled;
+extern std::array<std::atomic<uint64_t>, static_cast<int>(Counter::count)>
+    counters;
+void record(Stage stage, Clock::time_point begin, Clock::time_point end);
+}
+
+inline bool isEnabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+inline void count(Counter counter, uint64_t amount = 1) {
+    if (isEnabled()) {
+        detail::counters[static_cast<int>(counter)].fetch_add(
+            amount, std::memory_order_relaxed);
+    }
+}
+
+// Returns a counter's tally since the last call, and starts it over
+uint64_t takeCount(Counter counter);
+
+void setEnabled(bool enabled);
+
+// Starts logging every timer, enabling the profiler if it isn't already
+void startTrace();
+// Writes the events logged since startTrace() to path and stops logging.
+// Throws std::runtime_error if the file can't be written.
+void stopTrace(const std::string & path);
+bool isTracing();
+
+class Scope {
+public:
+    explicit Scope(Stage stage) : stage(stage), active(isEnabled()) {
+        if (active) {
+            begin = Clock::now();
+        }
+    }
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+    ~Scope() {
+        if (active) {
+            detail::record(stage, begin, Clock::now());
+        }
+    }
+
+private:
+    Stage stage;
+    bool active;
+    Clock::time_point begin;
+};
+
+// A table of per stage times, drawn over the game in window coordinates
+class Overlay {
+public:
+    Overlay();
+    // Refreshes the table twice a second from the timers' running totals.
+    // Status is shown under the table.
+    void update(const std::string & status);
+    void draw(sf::RenderTarget & target);
+
+private:
+    Clock::time_point lastRefresh;
+    std::array<uint64_t, static_cast<int>(Stage::count)> lastTotals;
+    std::array<uint64_t, static_cast<int>(Stage::count)> lastCounts;
+    sf::Text text;
+    sf::RectangleShape background;
+};
+}
@@ -0,0 +1,107 @@
+#include "renderBenchmark.hpp"
+#include "Game.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// The camera visits the spawn point, a handful of open tiles between it and
+// the teleporter, and the teleporter, at a constant speed
+static std::vector<sf::Vector2f> planFlythrough(tileController & tiles) {
+    const sf::Vector2f origin(tiles.getPosX(), tiles.getPosY());
+    const auto toWorld = [&origin](const Coordinate & c) {
+        return sf::Vector2f(origin.x + c.x * 32 + 16, origin.y + c.y * 26 + 13);
+    };
+    std::vector<sf::Vector2f> waypoints;
+    // The empty locations run from nearest the teleporter to furthest
+    const auto & locations = *tiles.getEmptyLocations();
+    static const int stops = 6;
+    for (int i = stops; i > 0 && !locations.empty(); --i) {
+        waypoints.push_back(
+            toWorld(locations[(locations.size() - 1) * i / stops]));
+    }
+    waypoints.push_back(toWorld(tiles.getTeleporterLoc()));
+    return waypoints;
+}
+
+static sf::Vector2f pointAlong(const std::vector<sf::Vector2f> & waypoints,
+                               float fraction) {
+    std::vector<float> lengths;
+    float total = 0;
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        const sf::Vector2f d = waypoints[i] - waypoints[i - 1];
+        lengths.push_back(std::sqrt(d.x * d.x + d.y * d.y));
+        total += lengths.back();
+    }
+    float distance = fraction * total;
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        if (distance <= lengths[i] && lengths[i] > 0) {
+            const float t = distance / lengths[i];
+            return waypoints[i] + (waypoints[i + 1] - waypoints[i]) * t;
+        }
+        distance -= lengths[i];
+    }
+    return waypoints.back();
+}
+
+void runRenderBenchmark(Game & game, int levels, int framesPerLevel) {
+    const bool wasEnabled = profiler::isEnabled();
+    profiler::setEnabled(true);
+    // Runs are only comparable at a fixed resolution
+    game.getDynamicResolution().setEnabled(false);
+    std::vector<double> frameMicros;
+    std::vector<uint64_t> drawCalls, sprites;
+    Camera & camera = game.getCamera();
+    game.transitionState = Game::TransitionState::None;
+    for (int level = 1; level <= levels; ++level) {
+        game.nextLevel();
+        game.transitionState = Game::TransitionState::None;
+        const auto waypoints = planFlythrough(game.getTileController());
+        for (int frame = 0; frame < framesPerLevel; ++frame) {
+            sf::View view = camera.getOverworldView();
+            const float fraction =
+                frame / float(std::max(framesPerLevel - 1, 1));
+            view.setCenter(pointAlong(waypoints, fraction));
+            camera.setOverworldView(view);
+            game.updateVisibility();
+            profiler::takeCount(profiler::Counter::drawCalls);
+            profiler::takeCount(profiler::Counter::sprites);
+            const auto start = profiler::Clock::now();
+            game.updateGraphics();
+            const std::chrono::duration<double, std::micro> elapsed =
+                profiler::Clock::now() - start;
+            frameMicros.push_back(elapsed.count());
+            drawCalls.push_back(
+                profiler::takeCount(profiler::Counter::drawCalls));
+            sprites.push_back(profiler::takeCount(profiler::Counter::sprites));
+            sf::Event event;
+            while (game.getWindow().pollEvent(event)) {
+            }
+        }
+    }
+    profiler::setEnabled(wasEnabled);
+    std::sort(frameMicros.begin(), frameMicros.end());
+    const auto percentile = [&frameMicros](int p) {
+        return frameMicros[std::min(frameMicros.size() - 1,
+                                    frameMicros.size() * p / 100)];
+    };
+    const auto report = [](const char * name,
+                           const std::vector<uint64_t> & values) {
+        uint64_t sum = 0, max = 0;
+        for (auto value : values) {
+            sum += value;
+            max = std::max(max, value);
+        }
+        std::cout << name << " per frame: mean "
+                  << double(sum) / values.size() << ", max " << max
+                  << std::endl;
+    };
+    std::cout << frameMicros.size() << " frames over " << levels
+              << " levels" << std::endl;
+    std::cout << "frame time (us): p50 " << percentile(50) << ", p95 "
+              << percentile(95) << ", p99 " << percentile(99) << ", max "
+              << frameMicros.back() << std::endl;
+    report("draw calls", drawCalls);
+    report("sprites", sprites);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+class Game;
+
+// Flies the camera over levels 1 to levels, drawing frames back to back, and
+// prints frame time percentiles and per frame draw call and sprite counts.
+// Nothing but the camera moves, so for a given seed every run draws the same
+// frames, and the numbers can be compared between builds. Vsync and the
+// frame rate limit should be off. Works with software OpenGL (e.g. Mesa's
+// llvmpipe), for machines without a GPU.
+void runRenderBenchmark(Game & game, int levels, int framesPerLevel = 240);
@@ -0,0 +1,164 @@
+#include "resourceArchive.hpp"
+
+#include <cstring>
+#ifdef BLINDJUMP_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ResourceArchive::ResourceArchive()
+    : mapping(nullptr), mappingSize(0), entries(nullptr), entryCount(0)
+#ifdef BLINDJUMP_WINDOWS
+      ,
+      fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+ResourceArchive::~ResourceArchive() { close(); }
+
+#ifdef BLINDJUMP_WINDOWS
+static const uint8_t * mapFile(const std::string & path, size_t & size,
+                               void *& fileHandle, void *& mappingHandle) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    HANDLE mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    void * view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return nullptr;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    fileHandle = file;
+    mappingHandle = mapping;
+    return static_cast<const uint8_t *>(view);
+}
+
+void ResourceArchive::close() {
+    if (mapping) {
+        UnmapViewOfFile(mapping);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+#else
+static const uint8_t * mapFile(const std::string & path, size_t & size) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void * view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                       MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return nullptr;
+    }
+    size = static_cast<size_t>(info.st_size);
+    return static_cast<const uint8_t *>(view);
+}
+
+void ResourceArchive::close() {
+    if (mapping) {
+        munmap(const_cast<uint8_t *>(mapping), mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+#endif
+
+// The pre-decoded formats are handed to SFML by their params, so those have
+// to agree with the blob's size, or SFML would read past its end
+static bool entryIsValid(const ArchiveEntry & entry, size_t mappingSize) {
+    if (entry.offset > mappingSize || entry.size > mappingSize - entry.offset ||
+        entry.name[sizeof(entry.name) - 1] != '\0') {
+        return false;
+    }
+    switch (entry.format) {
+    case ArchiveFormat::RawRGBA:
+        return entry.size ==
+               static_cast<uint64_t>(entry.params[0]) * entry.params[1] * 4;
+
+    case ArchiveFormat::RawPCM:
+        return entry.params[0] != 0 &&
+               entry.size % (sizeof(int16_t) * entry.params[0]) == 0;
+
+    default:
+        return true;
+    }
+}
+
+bool ResourceArchive::open(const std::string & path) {
+    close();
+#ifdef BLINDJUMP_WINDOWS
+    mapping = mapFile(path, mappingSize, fileHandle, mappingHandle);
+#else
+    mapping = mapFile(path, mappingSize);
+#endif
+    if (!mapping) {
+        return false;
+    }
+    const auto header = reinterpret_cast<const ArchiveHeader *>(mapping);
+    if (mappingSize < sizeof(ArchiveHeader) ||
+        std::memcmp(header->magic, "BJRA", 4) != 0 ||
+        header->version != archiveVersion ||
+        mappingSize < sizeof(ArchiveHeader) +
+                          header->entryCount * sizeof(ArchiveEntry)) {
+        close();
+        return false;
+    }
+    entries =
+        reinterpret_cast<const ArchiveEntry *>(mapping + sizeof(ArchiveHeader));
+    entryCount = header->entryCount;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        if (!entryIsValid(entries[i], mappingSize)) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResourceArchive::isOpen() const { return mapping != nullptr; }
+
+ResourceArchive::Blob ResourceArchive::find(const std::string & name) const {
+    // There are only a few dozen entries, a linear scan is fine
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        if (name == entries[i].name) {
+            return {mapping + entries[i].offset,
+                    static_cast<size_t>(entries[i].size), entries[i].format,
+                    entries[i].params};
+        }
+    }
+    return {nullptr, 0, ArchiveFormat::Encoded, nullptr};
+}
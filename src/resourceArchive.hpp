@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// The resource archive is a single file that bundles everything under res/,
+// written at build time by tools/respack.cpp. Layout:
+//
+//   ArchiveHeader | ArchiveEntry[entryCount] | blobs...
+//
+// Each blob starts on an archiveAlignment byte boundary, so that pre-decoded
+// pixels and samples can be handed to SFML straight out of the mapping. All
+// fields are little endian.
+
+static const uint32_t archiveVersion = 1;
+static const uint64_t archiveAlignment = 16;
+
+enum class ArchiveFormat : uint32_t {
+    Encoded, // The original file's bytes, params unused
+    RawRGBA, // 8 bit RGBA pixels, params: width, height
+    RawPCM   // 16 bit interleaved samples, params: channels, sample rate
+};
+
+struct ArchiveHeader {
+    char magic[4]; // "BJRA"
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct ArchiveEntry {
+    char name[48]; // Path relative to res/, nul terminated
+    ArchiveFormat format;
+    uint32_t params[3];
+    uint64_t offset; // From the start of the file
+    uint64_t size;
+};
+
+static_assert(sizeof(ArchiveHeader) == 16, "ArchiveHeader must be packed");
+static_assert(sizeof(ArchiveEntry) == 80, "ArchiveEntry must be packed");
+
+class ResourceArchive {
+public:
+    struct Blob {
+        const void * data;
+        size_t size;
+        ArchiveFormat format;
+        const uint32_t * params;
+    };
+    ResourceArchive();
+    ResourceArchive(const ResourceArchive &) = delete;
+    ResourceArchive & operator=(const ResourceArchive &) = delete;
+    ~ResourceArchive();
+    // Maps the archive into memory. Returns false if the file doesn't exist
+    // or isn't a valid archive, in which case the object stays empty. An
+    // archive is invalid if any entry runs past the end of the file, or
+    // holds pixels or samples that don't match its params.
+    bool open(const std::string & path);
+    bool isOpen() const;
+    // Returns a blob with a null data pointer if name isn't in the archive
+    Blob find(const std::string & name) const;
+
+private:
+    void close();
+    const uint8_t * mapping;
+    size_t mappingSize;
+    const ArchiveEntry * entries;
+    uint32_t entryCount;
+#ifdef BLINDJUMP_WINDOWS
+    void * fileHandle;
+    void * mappingHandle;
+#endif
+};
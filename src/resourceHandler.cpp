@@ -1,126 +1,360 @@
 #include "resourceHandler.hpp"
+#include "alias.hpp"
+#include "framework/workerPool.hpp"
+#include <fstream>
+#include <functional>
+#include <future>
+#include <sstream>
 
 static const char * LOAD_FAILURE_MSG = "blindjump [crash]: missing resource";
 
-template <typename T, typename E>
-void loadResource(const std::string & str, E id, T & array) {
-    int idx = static_cast<int>(id);
-    if (!array[idx].loadFromFile(str)) {
+// Paths are relative to the resource directory, and listed in the same order
+// as the enums in ResHandler, so that the enum value indexes into the table.
+static const std::array<const char *,
+                        static_cast<int>(ResHandler::Texture::count)>
+    texturePaths{{"textures/gameObjects.png", "textures/vignetteMask.png",
+                  "textures/vignetteShadow.png", "textures/lampLight.png",
+                  "textures/introLevel.png", "textures/teleporterGlow.png",
+                  "textures/introWall.png", "textures/redFloorGlow.png",
+                  "textures/blueFloorGlow.png",
+                  "textures/fireExplosionGlow.png",
+                  "textures/whiteFloorGlow.png",
+                  "textures/charger_enemy_shadow.png",
+                  "textures/teleporterBeamGlow.png", "textures/bkg_stars.png",
+                  "textures/bkg_stars_distant.png", "textures/bkg_orbit2.png",
+                  "textures/introLevelMask.png", "textures/powerupSheet.png",
+                  "textures/yellowGlow.png"}};
+
+static const std::array<const char *,
+                        static_cast<int>(ResHandler::Shader::count)>
+    shaderPaths{{"shaders/color.frag", "shaders/blur.frag",
+                 "shaders/composite.frag", "shaders/composite.frag"}};
+
+// Prepended to the source, for shaders built as variants of the same file
+static const std::array<const char *,
+                        static_cast<int>(ResHandler::Shader::count)>
+    shaderDefines{{"", "", "", "#define BLUR\n"}};
+
+static const std::array<const char *, static_cast<int>(ResHandler::Font::count)>
+    fontPaths{{"fonts/Cornerstone.ttf"}};
+
+static const std::array<const char *,
+                        static_cast<int>(ResHandler::Image::count)>
+    imagePaths{{"textures/soilTileset.png", "textures/grassSet.png",
+                "textures/grassSetEdge.png", "textures/gameIcon.png"}};
+
+static const std::array<const char *,
+                        static_cast<int>(ResHandler::Sound::count)>
+    soundPaths{{"sounds/gunshot.ogg", "sounds/creak.ogg",
+                "sounds/bite-small.wav", "sounds/bite-small3.wav",
+                "sounds/woosh.ogg", "sounds/wooshMono.ogg", "sounds/espark.ogg",
+                "sounds/silenced.ogg", "sounds/laser.ogg", "sounds/blast1.ogg",
+                "sounds/electricHum.ogg", "sounds/footstepDirt1.ogg",
+                "sounds/footstepDirt2.ogg", "sounds/footstepDirt3.ogg",
+                "sounds/footstepDirt4.ogg", "sounds/footstepDirt5.ogg"}};
+
+struct DecodedSound {
+    std::vector<sf::Int16> samples;
+    unsigned channelCount;
+    unsigned sampleRate;
+};
+
+static microseconds elapsedSince(const time_point & start) {
+    return std::chrono::duration_cast<microseconds>(
+        high_resolution_clock::now() - start);
+}
+
+// Assets come out of the resource archive when there is one, and from the
+// loose files in the resource directory otherwise.
+static void decodeImage(const ResourceArchive & archive,
+                        const std::string & resPath, const char * name,
+                        sf::Image & image) {
+    const ResourceArchive::Blob blob = archive.find(name);
+    bool success;
+    if (!blob.data) {
+        success = image.loadFromFile(resPath + name);
+    } else if (blob.format == ArchiveFormat::RawRGBA) {
+        image.create(blob.params[0], blob.params[1],
+                     static_cast<const sf::Uint8 *>(blob.data));
+        success = true;
+    } else {
+        success = image.loadFromMemory(blob.data, blob.size);
+    }
+    if (!success) {
+        throw std::runtime_error(LOAD_FAILURE_MSG);
+    }
+}
+
+static void decodeSound(const ResourceArchive & archive,
+                        const std::string & resPath, const char * name,
+                        DecodedSound & sound) {
+    const ResourceArchive::Blob blob = archive.find(name);
+    sf::InputSoundFile file;
+    const bool success = blob.data ? file.openFromMemory(blob.data, blob.size)
+                                   : file.openFromFile(resPath + name);
+    if (!success) {
+        throw std::runtime_error(LOAD_FAILURE_MSG);
+    }
+    sound.channelCount = file.getChannelCount();
+    sound.sampleRate = file.getSampleRate();
+    sound.samples.resize(static_cast<size_t>(file.getSampleCount()));
+    if (file.read(sound.samples.data(), sound.samples.size()) !=
+        sound.samples.size()) {
         throw std::runtime_error(LOAD_FAILURE_MSG);
     }
 }
 
-template <>
-void loadResource(
-    const std::string & str, ResHandler::Shader id,
-    std::array<sf::Shader, static_cast<int>(ResHandler::Shader::count)> &
-        shaders) {
-    size_t index = static_cast<int>(id);
-    if (!shaders[index].loadFromFile(str, sf::Shader::Fragment)) {
+static void readShaderSource(const ResourceArchive & archive,
+                             const std::string & resPath, const char * name,
+                             std::string & source) {
+    const ResourceArchive::Blob blob = archive.find(name);
+    if (blob.data) {
+        source.assign(static_cast<const char *>(blob.data), blob.size);
+        return;
+    }
+    std::ifstream file(resPath + name);
+    if (!file) {
         throw std::runtime_error(LOAD_FAILURE_MSG);
     }
-    shaders[index].setUniform("texture", sf::Shader::CurrentTexture);
+    std::stringstream stream;
+    stream << file.rdbuf();
+    source = stream.str();
+}
+
+static bool isPreDecoded(const ResourceArchive & archive, const char * name) {
+    const ResourceArchive::Blob blob = archive.find(name);
+    return blob.data && blob.format != ArchiveFormat::Encoded;
 }
 
+struct ResHandler::PendingLoad {
+    struct Step {
+        std::future<void> decoded;
+        size_t timingSlot;
+        std::function<void()> upload;
+    };
+    time_point start;
+    std::string resPath;
+    std::vector<sf::Image> textureImages;
+    std::vector<DecodedSound> decodedSounds;
+    std::vector<std::string> shaderSources;
+    std::vector<Step> steps;
+    // Declared last, so that the workers are joined before the staging
+    // buffers above are destroyed
+    WorkerPool workers;
+};
+
+ResHandler::ResHandler() : totalLoadTime(0) {}
+
+ResHandler::~ResHandler() {}
+
 static bool hasResources;
 
-void ResHandler::load() {
+void ResHandler::beginLoad() {
     assert(!hasResources);
     hasResources = true;
-    const std::string resPath = resourcePath();
-    loadShaders(resPath);
-    loadTextures(resPath);
-    loadFonts(resPath);
-    loadImages(resPath);
-    loadSounds(resPath);
-}
-
-void ResHandler::loadShaders(const std::string & resPath) {
-    loadResource(resPath + "shaders/desaturate.frag", Shader::desaturate,
-                 shaders);
-    loadResource(resPath + "shaders/color.frag", Shader::color, shaders);
-    loadResource(resPath + "shaders/blur.frag", Shader::blur, shaders);
-}
-
-void ResHandler::loadTextures(const std::string & resPath) {
-    loadResource(resPath + "textures/teleporterBeamGlow.png",
-                 Texture::teleporterBeamGlow, textures);
-    loadResource(resPath + "textures/fireExplosionGlow.png",
-                 Texture::fireExplosionGlow, textures);
-    loadResource(resPath + "textures/charger_enemy_shadow.png",
-                 Texture::scootShadow, textures);
-    loadResource(resPath + "textures/vignetteShadow.png",
-                 Texture::vignetteShadow, textures);
-    loadResource(resPath + "textures/teleporterGlow.png",
-                 Texture::teleporterGlow, textures);
-    loadResource(resPath + "textures/bkg_stars_distant.png",
-                 Texture::bkgStarsFar, textures);
-    loadResource(resPath + "textures/introLevelMask.png",
-                 Texture::introLevelMask, textures);
-    loadResource(resPath + "textures/powerupSheet.png", Texture::powerupSheet,
-                 textures);
-    loadResource(resPath + "textures/whiteFloorGlow.png", Texture::whiteGlow,
-                 textures);
-    loadResource(resPath + "textures/gameObjects.png", Texture::gameObjects,
-                 textures);
-    loadResource(resPath + "textures/blueFloorGlow.png", Texture::blueglow,
-                 textures);
-    loadResource(resPath + "textures/bkg_stars.png", Texture::bkgStarsNear,
-                 textures);
-    loadResource(resPath + "textures/vignetteMask.png", Texture::vignette,
-                 textures);
-    loadResource(resPath + "textures/introLevel.png", Texture::introLevel,
-                 textures);
-    loadResource(resPath + "textures/redFloorGlow.png", Texture::redglow,
-                 textures);
-    loadResource(resPath + "textures/lampLight.png", Texture::lamplight,
-                 textures);
-    loadResource(resPath + "textures/introWall.png", Texture::introWall,
-                 textures);
-    loadResource(resPath + "textures/bkg_orbit2.png", Texture::bkgOrbit,
-                 textures);
-    loadResource(resPath + "textures/yellowGlow.png", Texture::yellowGlow,
-                 textures);
-}
-
-void ResHandler::loadFonts(const std::string & resPath) {
-    loadResource(resPath + "fonts/Cornerstone.ttf", Font::cornerstone, fonts);
-}
-
-void ResHandler::loadImages(const std::string & resPath) {
-    loadResource(resPath + "textures/soilTileset.png", Image::soilTileset,
-                 images);
-    loadResource(resPath + "textures/grassSetEdge.png", Image::grassSet2,
-                 images);
-    loadResource(resPath + "textures/grassSet.png", Image::grassSet1, images);
-    loadResource(resPath + "textures/gameIcon.png", Image::icon, images);
-}
-
-void ResHandler::loadSounds(const std::string & resPath) {
-    loadResource(resPath + "sounds/gunshot.ogg", Sound::gunShot, sounds);
-    loadResource(resPath + "sounds/creak.ogg", Sound::creak, sounds);
-    loadResource(resPath + "sounds/bite-small.wav", Sound::bite1, sounds);
-    loadResource(resPath + "sounds/bite-small3.wav", Sound::bite2, sounds);
-    loadResource(resPath + "sounds/woosh.ogg", Sound::woosh, sounds);
-    loadResource(resPath + "sounds/wooshMono.ogg", Sound::wooshMono, sounds);
-    loadResource(resPath + "sounds/espark.ogg", Sound::espark, sounds);
-    loadResource(resPath + "sounds/silenced.ogg", Sound::silenced, sounds);
-    loadResource(resPath + "sounds/laser.ogg", Sound::laser, sounds);
-    loadResource(resPath + "sounds/blast1.ogg", Sound::blast1, sounds);
-    loadResource(resPath + "sounds/electricHum.ogg", Sound::electricHum,
-                 sounds);
-    loadResource(resPath + "sounds/footstepDirt1.ogg", Sound::footstepDirt1,
-                 sounds);
-    loadResource(resPath + "sounds/footstepDirt2.ogg", Sound::footstepDirt2,
-                 sounds);
-    loadResource(resPath + "sounds/footstepDirt3.ogg", Sound::footstepDirt3,
-                 sounds);
-    loadResource(resPath + "sounds/footstepDirt4.ogg", Sound::footstepDirt4,
-                 sounds);
-    loadResource(resPath + "sounds/footstepDirt5.ogg", Sound::footstepDirt5,
-                 sounds);
+    pendingLoad.reset(new PendingLoad);
+    PendingLoad & pending = *pendingLoad;
+    pending.start = high_resolution_clock::now();
+    pending.resPath = resourcePath();
+    const std::string & resPath = pending.resPath;
+    const std::string archivePath = resPath + "resources.pak";
+    // Without an archive the loose files are used, but a broken one is an
+    // error, rather than a reason to quietly fall back
+    if (!archive.open(archivePath) && std::ifstream(archivePath)) {
+        throw std::runtime_error(LOAD_FAILURE_MSG);
+    }
+    static const size_t textureCount = texturePaths.size();
+    static const size_t imageCount = imagePaths.size();
+    static const size_t soundCount = soundPaths.size();
+    static const size_t shaderCount = shaderPaths.size();
+    // Timing slots are preallocated so that each job writes only to its own
+    // entry. Order: fonts, textures, images, sounds, shaders.
+    loadTimings.clear();
+    loadTimings.resize(fontPaths.size() + textureCount + imageCount +
+                       soundCount + shaderCount);
+    const size_t textureSlot = fontPaths.size();
+    const size_t imageSlot = textureSlot + textureCount;
+    const size_t soundSlot = imageSlot + imageCount;
+    const size_t shaderSlot = soundSlot + soundCount;
+    // Fonts are opened lazily by freetype, so there's nothing worth handing
+    // off to the workers, and the intro sequence needs them right away.
+    for (size_t i = 0; i < fontPaths.size(); ++i) {
+        const time_point start = high_resolution_clock::now();
+        loadTimings[i].name = fontPaths[i];
+        const ResourceArchive::Blob blob = archive.find(fontPaths[i]);
+        const bool success = blob.data
+                                 ? fonts[i].loadFromMemory(blob.data, blob.size)
+                                 : fonts[i].loadFromFile(resPath + fontPaths[i]);
+        if (!success) {
+            throw std::runtime_error(LOAD_FAILURE_MSG);
+        }
+        loadTimings[i].upload = elapsedSince(start);
+    }
+    pending.textureImages.resize(textureCount);
+    pending.decodedSounds.resize(soundCount);
+    pending.shaderSources.resize(shaderCount);
+    // SFML registers its sound file readers lazily and without a lock, so the
+    // first encoded sound needs to be opened before any worker does.
+    size_t firstEncodedSound = 0;
+    while (firstEncodedSound < soundCount &&
+           isPreDecoded(archive, soundPaths[firstEncodedSound])) {
+        ++firstEncodedSound;
+    }
+    if (firstEncodedSound < soundCount) {
+        const time_point start = high_resolution_clock::now();
+        decodeSound(archive, resPath, soundPaths[firstEncodedSound],
+                    pending.decodedSounds[firstEncodedSound]);
+        loadTimings[soundSlot + firstEncodedSound].decode =
+            elapsedSince(start);
+    }
+    auto enqueue = [this, &pending](size_t slot, const char * name,
+                                    auto decoder, auto upload) {
+        loadTimings[slot].name = name;
+        auto decoded = pending.workers.submit([this, slot, decoder] {
+            const time_point start = high_resolution_clock::now();
+            decoder();
+            loadTimings[slot].decode = elapsedSince(start);
+        });
+        pending.steps.push_back({std::move(decoded), slot, upload});
+    };
+    for (size_t i = 0; i < textureCount; ++i) {
+        const char * name = texturePaths[i];
+        sf::Image & image = pending.textureImages[i];
+        if (isPreDecoded(archive, name)) {
+            // Uploaded straight out of the mapped archive
+            enqueue(textureSlot + i, name, [] {}, [this, name, i] {
+                const ResourceArchive::Blob blob = archive.find(name);
+                if (!textures[i].create(blob.params[0], blob.params[1])) {
+                    throw std::runtime_error(LOAD_FAILURE_MSG);
+                }
+                textures[i].update(static_cast<const sf::Uint8 *>(blob.data));
+            });
+            continue;
+        }
+        enqueue(textureSlot + i, name,
+                [this, &resPath, &image, name] {
+                    decodeImage(archive, resPath, name, image);
+                },
+                [this, &image, i] {
+                    if (!textures[i].loadFromImage(image)) {
+                        throw std::runtime_error(LOAD_FAILURE_MSG);
+                    }
+                    image = sf::Image();
+                });
+    }
+    for (size_t i = 0; i < imageCount; ++i) {
+        const char * name = imagePaths[i];
+        sf::Image & image = images[i];
+        enqueue(imageSlot + i, name,
+                [this, &resPath, &image, name] {
+                    decodeImage(archive, resPath, name, image);
+                },
+                [] {});
+    }
+    for (size_t i = 0; i < soundCount; ++i) {
+        const char * name = soundPaths[i];
+        if (isPreDecoded(archive, name)) {
+            enqueue(soundSlot + i, name, [] {}, [this, name, i] {
+                const ResourceArchive::Blob blob = archive.find(name);
+                if (!sounds[i].loadFromSamples(
+                        static_cast<const sf::Int16 *>(blob.data),
+                        blob.size / sizeof(sf::Int16), blob.params[0],
+                        blob.params[1])) {
+                    throw std::runtime_error(LOAD_FAILURE_MSG);
+                }
+            });
+            continue;
+        }
+        DecodedSound & decoded = pending.decodedSounds[i];
+        auto upload = [this, &decoded, i] {
+            if (!sounds[i].loadFromSamples(
+                    decoded.samples.data(), decoded.samples.size(),
+                    decoded.channelCount, decoded.sampleRate)) {
+                throw std::runtime_error(LOAD_FAILURE_MSG);
+            }
+            decoded.samples = std::vector<sf::Int16>();
+        };
+        if (i == firstEncodedSound) {
+            std::promise<void> done;
+            done.set_value();
+            loadTimings[soundSlot + i].name = name;
+            pending.steps.push_back({done.get_future(), soundSlot + i, upload});
+        } else {
+            enqueue(soundSlot + i, name,
+                    [this, &resPath, &decoded, name] {
+                        decodeSound(archive, resPath, name, decoded);
+                    },
+                    upload);
+        }
+    }
+    for (size_t i = 0; i < shaderCount; ++i) {
+        const char * name = shaderPaths[i];
+        std::string & shaderSource = pending.shaderSources[i];
+        enqueue(shaderSlot + i, name,
+                [this, &resPath, &shaderSource, name] {
+                    readShaderSource(archive, resPath, name, shaderSource);
+                },
+                [this, &shaderSource, i] {
+                    if (!shaders[i].loadFromMemory(shaderDefines[i] +
+                                                       shaderSource,
+                                                   sf::Shader::Fragment)) {
+                        throw std::runtime_error(LOAD_FAILURE_MSG);
+                    }
+                    shaders[i].setUniform("texture",
+                                          sf::Shader::CurrentTexture);
+                });
+    }
 }
 
+bool ResHandler::pumpLoad(bool block, microseconds budget) {
+    if (!pendingLoad) {
+        return true;
+    }
+    auto & steps = pendingLoad->steps;
+    const time_point pumpStart = high_resolution_clock::now();
+    for (auto it = steps.begin(); it != steps.end();) {
+        if (!block && elapsedSince(pumpStart) >= budget) {
+            return false;
+        }
+        if (!block && it->decoded.wait_for(std::chrono::seconds(0)) !=
+                          std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        // Rethrows the decoding error, if there was one
+        it->decoded.get();
+        const time_point start = high_resolution_clock::now();
+        it->upload();
+        loadTimings[it->timingSlot].upload = elapsedSince(start);
+        it = steps.erase(it);
+    }
+    if (!steps.empty()) {
+        return false;
+    }
+    totalLoadTime = elapsedSince(pendingLoad->start);
+    pendingLoad.reset();
+    return true;
+}
+
+bool ResHandler::continueLoad(microseconds budget) {
+    return pumpLoad(false, budget);
+}
+
+void ResHandler::finishLoad() { pumpLoad(true, microseconds(0)); }
+
+void ResHandler::load() {
+    beginLoad();
+    finishLoad();
+}
+
+const std::vector<ResHandler::LoadTiming> & ResHandler::getLoadTimings() const {
+    return loadTimings;
+}
+
+microseconds ResHandler::getTotalLoadTime() const { return totalLoadTime; }
+
+const ResourceArchive & ResHandler::getArchive() const { return archive; }
+
 const sf::Image & ResHandler::getImage(Image id) const {
     return images[static_cast<int>(id)];
 }
@@ -4,10 +4,15 @@
 #include <SFML/Graphics.hpp>
 #include <array>
 #include <assert.h>
+#include <chrono>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "ResourcePath.hpp"
+#include "resourceArchive.hpp"
 
 class ResHandler {
 public:
@@ -33,7 +38,7 @@ public:
         yellowGlow,
         count
     };
-    enum class Shader { color, blur, desaturate, count };
+    enum class Shader { color, blur, composite, compositeBlur, count };
     enum class Font { cornerstone, count };
     enum class Image { soilTileset, grassSet1, grassSet2, icon, count };
     enum class Sound {
@@ -62,7 +67,30 @@ public:
     const sf::SoundBuffer & getSound(ResHandler::Sound) const;
     sf::Shader & getShader(ResHandler::Shader)
         const; // Exception: shader cannot be a constant reference
+    ResHandler();
+    ~ResHandler();
+    // Loading is staged so that something can be shown on screen while it's
+    // still in progress. beginLoad() loads the fonts right away, and queues
+    // decoding of the images and audio files on a pool of worker threads.
+    // continueLoad() then does as many of the texture uploads and shader
+    // compiles as it can within the time budget, and returns true once every
+    // resource is available, and finishLoad() blocks until it is. These need
+    // to be called from the thread that owns the OpenGL context. load() does
+    // all of it in one blocking call.
+    void beginLoad();
+    bool continueLoad(std::chrono::microseconds budget);
+    void finishLoad();
     void load();
+    struct LoadTiming {
+        std::string name;
+        std::chrono::microseconds decode, upload;
+    };
+    // Per-asset cost of the most recent load, in the order it was queued
+    const std::vector<LoadTiming> & getLoadTimings() const;
+    std::chrono::microseconds getTotalLoadTime() const;
+    // The packed resources, if res/resources.pak exists. Fonts and music
+    // stream out of the mapping, so it stays open for the handler's lifetime.
+    const ResourceArchive & getArchive() const;
 
 private:
     mutable std::array<sf::Shader, static_cast<int>(Shader::count)> shaders;
@@ -70,11 +98,12 @@ private:
     std::array<sf::Font, static_cast<int>(Font::count)> fonts;
     std::array<sf::Image, static_cast<int>(Image::count)> images;
     std::array<sf::SoundBuffer, static_cast<int>(Sound::count)> sounds;
-    void loadShaders(const std::string &);
-    void loadTextures(const std::string &);
-    void loadFonts(const std::string &);
-    void loadImages(const std::string &);
-    void loadSounds(const std::string &);
+    ResourceArchive archive;
+    std::vector<LoadTiming> loadTimings;
+    std::chrono::microseconds totalLoadTime;
+    struct PendingLoad;
+    std::unique_ptr<PendingLoad> pendingLoad;
+    bool pumpLoad(bool block, std::chrono::microseconds budget);
 };
 
 void setgResHandlerPtr(ResHandler *);
@@ -1,5 +1,48 @@
 #include "rng.hpp"
+#include <ctime>
+#include <random>
 
 namespace rng {
-std::mt19937 RNG;
+namespace detail {
+static std::atomic<uint64_t> runSeed;
+// Starts at one, so that a thread's zeroed streams are seeded on first use
+std::atomic<unsigned> generation(1);
+thread_local ThreadStreams threadStreams;
+
+static uint64_t splitMix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+void refresh(ThreadStreams & local, unsigned current) {
+    for (int i = 0; i < static_cast<int>(Stream::count); ++i) {
+        local.streams[i] = makeGenerator(static_cast<Stream>(i), 0);
+    }
+    local.generation = current;
+}
+}
+
+void seed() {
+    std::random_device rd;
+    seed((static_cast<uint64_t>(rd()) << 32) ^ rd() ^
+         static_cast<uint64_t>(std::time(nullptr)));
+}
+
+void seed(uint64_t runSeed) {
+    detail::runSeed.store(runSeed, std::memory_order_relaxed);
+    detail::generation.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t getSeed() { return detail::runSeed.load(std::memory_order_relaxed); }
+
+Generator makeGenerator(Stream stream, uint64_t key) {
+    return Generator(detail::splitMix(getSeed() ^ detail::splitMix(key)),
+                     static_cast<uint64_t>(stream));
+}
+
+void reseed(Stream stream, uint64_t key) {
+    get(stream) = makeGenerator(stream, key);
+}
 }
@@ -1,21 +1,114 @@
 #pragma once
-#include <cmath>
-#include <ctime>
-#include <random>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <stdint.h>
 
+// Random numbers come from independent named streams, so that e.g. an enemy
+// rolling for a heart drop doesn't shift the layout of every level after it.
+// Each thread has its own copy of every stream, seeded from the run seed and
+// the stream id, which keeps the streams lock free. For runs to be
+// reproducible, each stream should only be drawn from by one thread at a
+// time: mapgen by whoever builds the level, ai and fx by the logic thread.
 namespace rng {
-extern std::mt19937 RNG;
+enum class Stream { mapgen, ai, fx, audio, count };
 
-template <size_t upper, int lower = 0> int random() {
-    return std::abs(static_cast<int>(RNG())) % upper + lower;
+// PCG32 (XSH-RR variant). Satisfies UniformRandomBitGenerator, so that it can
+// be passed to std::shuffle and the <random> distributions.
+class Generator {
+public:
+    using result_type = uint32_t;
+    Generator() : Generator(0, 0) {}
+    Generator(uint64_t seed, uint64_t sequence) { this->seed(seed, sequence); }
+    void seed(uint64_t seed, uint64_t sequence) {
+        state = 0;
+        increment = (sequence << 1) | 1;
+        (*this)();
+        state += seed;
+        (*this)();
+    }
+    result_type operator()() {
+        const uint64_t old = state;
+        state = old * 6364136223846793005ull + increment;
+        const uint32_t xorShifted =
+            static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+    }
+    // Uniform in [0, upper), without the bias of taking a modulus (Lemire's
+    // multiply and reject method). Returns 0 if upper is 0.
+    uint32_t bounded(uint32_t upper) {
+        uint64_t product = static_cast<uint64_t>((*this)()) * upper;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < upper) {
+            const uint32_t threshold = (0u - upper) % upper;
+            while (low < threshold) {
+                product = static_cast<uint64_t>((*this)()) * upper;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
+
+// Seeds every stream on every thread. The first overload picks a seed from
+// the system's entropy source.
+void seed();
+void seed(uint64_t runSeed);
+uint64_t getSeed();
+
+// Restarts one stream on the calling thread at a point derived from the run
+// seed and key, e.g. the mapgen stream at the start of each level, so that a
+// level's layout depends only on the seed and the level number.
+void reseed(Stream stream, uint64_t key);
+
+// A generator seeded the same way reseed() would, for work handed off to
+// other threads.
+Generator makeGenerator(Stream stream, uint64_t key);
+
+namespace detail {
+struct ThreadStreams {
+    unsigned generation = 0;
+    std::array<Generator, static_cast<int>(Stream::count)> streams;
+};
+extern std::atomic<unsigned> generation;
+extern thread_local ThreadStreams threadStreams;
+void refresh(ThreadStreams & local, unsigned current);
+}
+
+inline Generator & get(Stream stream) {
+    auto & local = detail::threadStreams;
+    const unsigned current = detail::generation.load(std::memory_order_acquire);
+    if (local.generation != current) {
+        detail::refresh(local, current);
+    }
+    return local.streams[static_cast<int>(stream)];
+}
+
+template <size_t upper, int lower = 0> int random(Generator & generator) {
+    static_assert(upper > 0, "rng::random needs a non-empty range");
+    return static_cast<int>(generator.bounded(upper)) + lower;
+}
+
+inline int random(Generator & generator, size_t upper, int lower = 0) {
+    return static_cast<int>(generator.bounded(static_cast<uint32_t>(upper))) +
+           lower;
 }
 
-inline int random(size_t upper, int lower = 0) {
-    return std::abs(static_cast<int>(RNG())) % upper + lower;
+template <size_t upper, int lower = 0> int random(Stream stream) {
+    return random<upper, lower>(get(stream));
 }
 
-inline void seed() {
-    std::random_device rd;
-    RNG.seed(rd() ^ static_cast<unsigned>(std::time(nullptr)));
+inline int random(Stream stream, size_t upper, int lower = 0) {
+    return random(get(stream), upper, lower);
 }
 }
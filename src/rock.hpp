@@ -13,11 +13,11 @@ public:
     _Rock(float _xPos, float _yPos, const sf::Texture & inpTxtr)
         : Object(_xPos, _yPos) {
         rockSheet.setTexture(inpTxtr);
-        if (rng::random<2>()) {
+        if (rng::random<2>(rng::Stream::mapgen)) {
             rockSheet.setScale(-1, 1);
             position.x += 32;
         }
-        rockSheet[rng::random<4>()];
+        rockSheet[rng::random<4>(rng::Stream::mapgen)];
         rockSheet.setPosition(position.x, position.y);
     }
     template <typename Game> void update(const sf::Time &, Game *) {}
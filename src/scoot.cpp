@@ -4,29 +4,116 @@
 #include "player.hpp"
 #include <cmath>
 
-Scoot::Scoot(const sf::Texture & mainTxtr, const sf::Texture & shadowTxtr,
-             float _xPos, float _yPos)
-    : Enemy(_xPos, _yPos), spriteSheet(mainTxtr), speedScale(0.5f),
-      state(State::drift1), timer(rng::random<1800>()) {
+ScootGroup::ScootGroup() {
+    spriteSheet.setTexture(
+        getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects));
     spriteSheet.setOrigin(6, 6);
-    hitBox.setPosition(position.x, position.y);
-    shadow.setTexture(shadowTxtr);
-    float dir = rng::random<359>();
-    hSpeed = cos(dir) * 0.5;
-    vSpeed = sin(dir) * 0.5;
-    health = 2;
+    shadow.setTexture(
+        getgResHandlerPtr()->getTexture(ResHandler::Texture::scootShadow));
 }
 
-const Scoot::HBox & Scoot::getHitBox() const { return hitBox; }
+void ScootGroup::add(float x, float y) {
+    const int32_t timer = rng::random<1800>(rng::Stream::ai);
+    const float dir = rng::random<359>(rng::Stream::ai);
+    kinematics.add(x, y, std::cos(dir) * 0.5f, std::sin(dir) * 0.5f, 2);
+    kinematics.speedScale.back() = 0.5f;
+    timers.push_back(timer);
+    frameTimers.push_back(0);
+    frameIndices.push_back(0);
+    facingRight.push_back(false);
+    anchors.push_back(std::make_shared<Object>(x, y));
+}
+
+void ScootGroup::clear() {
+    kinematics.clear();
+    timers.clear();
+    frameTimers.clear();
+    frameIndices.clear();
+    facingRight.clear();
+    anchors.clear();
+}
+
+template <typename T> static void removeAt(std::vector<T> & vec, size_t index) {
+    vec[index] = std::move(vec.back());
+    vec.pop_back();
+}
+
+void ScootGroup::removeAt(size_t index) {
+    anchors[index]->setKillFlag();
+    kinematics.removeAt(index);
+    ::removeAt(timers, index);
+    ::removeAt(frameTimers, index);
+    ::removeAt(frameIndices, index);
+    ::removeAt(facingRight, index);
+    ::removeAt(anchors, index);
+}
+
+void ScootGroup::update(Game * pGame, bool enabled,
+                        const tileController & tiles,
+                        const SimulationLod & lod,
+                        std::vector<sf::Vector2f> & cameraTargets) {
+    const size_t count = kinematics.size();
+    if (enabled) {
+        // The anchors were placed in the VisibilitySet, so they know how far
+        // from the view their scoots are
+        for (size_t i = 0; i < count; ++i) {
+            kinematics.tier[i] =
+                SimulationLod::tierOf(anchors[i]->getProximity());
+        }
+        kinematics.schedule(lod);
+        for (size_t i = 0; i < count; ++i) {
+            if (kinematics.tier[i] == SimulationLod::Tier::full) {
+                think(i, pGame, tiles, sf::microseconds(kinematics.step[i]));
+            } else if (kinematics.step[i]) {
+                bounce(i, tiles);
+            }
+        }
+        kinematics.decayColor();
+        kinematics.integrate(0.00006f);
+        for (size_t i = 0; i < count; ++i) {
+            frameTimers[i] += kinematics.step[i] / 1000;
+            const bool nextFrame = frameTimers[i] > 87;
+            frameTimers[i] -= nextFrame ? 87 : 0;
+            frameIndices[i] ^= nextFrame;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            anchors[i]->setPosition(kinematics.x[i], kinematics.y[i]);
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (anchors[i]->isOnScreen()) {
+            cameraTargets.emplace_back(kinematics.x[i], kinematics.y[i]);
+        }
+    }
+}
+
+ScootGroup::State ScootGroup::getState(size_t index) const {
+    return static_cast<State>(kinematics.state[index]);
+}
+
+void ScootGroup::setState(size_t index, State state) {
+    kinematics.state[index] = static_cast<uint8_t>(state);
+}
 
-void Scoot::changeDir(float dir) {
-    hSpeed = std::cos(dir);
-    vSpeed = std::sin(dir);
+void ScootGroup::changeDir(size_t index, float dir) {
+    kinematics.hSpeed[index] = std::cos(dir);
+    kinematics.vSpeed[index] = std::sin(dir);
 }
 
-void Scoot::update(Game * pGame, const std::vector<wall> & w,
-                   const sf::Time & elapsedTime) {
+// Everything but moving, fading and animating, which update() does for all
+// of the scoots at once afterwards. Only the scoots on screen think.
+void ScootGroup::think(size_t i, Game * pGame, const tileController & tiles,
+                       const sf::Time & elapsedTime) {
+    const float x = kinematics.x[i];
+    const float y = kinematics.y[i];
+    uint8_t & health = kinematics.health[i];
+    float & hSpeed = kinematics.hSpeed[i];
+    float & vSpeed = kinematics.vSpeed[i];
+    float & speedScale = kinematics.speedScale[i];
+    int32_t & timer = timers[i];
     EffectGroup & effects = pGame->getEffects();
+    HBox hitBox;
+    hitBox.setPosition(x, y);
     for (auto & element : effects.get<EffectRef::PlayerShot>()) {
         if (hitBox.overlapping(element->getHitBox()) &&
             element->checkCanPoof()) {
@@ -36,8 +123,7 @@ void Scoot::update(Game * pGame, const std::vector<wall> & w,
             }
             element->poof();
             health -= 1;
-            colored = true;
-            colorAmount = 1.f;
+            kinematics.colorAmount[i] = 1.f;
         }
     }
     for (auto & helper : pGame->getHelperGroup().get<HelperRef::Laika>()) {
@@ -46,49 +132,37 @@ void Scoot::update(Game * pGame, const std::vector<wall> & w,
         }
     }
     if (health == 0) {
-        int select = rng::random<5>();
+        int select = rng::random<5>(rng::Stream::ai);
         if (select == 0) {
             effects.add<EffectRef::Heart>(
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
                 getgResHandlerPtr()->getTexture(ResHandler::Texture::redglow),
-                position.x, position.y + 4, Item::Type::Heart);
+                x, y + 4, Item::Type::Heart);
         } else {
             effects.add<EffectRef::Coin>(
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
                 getgResHandlerPtr()->getTexture(ResHandler::Texture::blueglow),
-                position.x, position.y + 4, Item::Type::Coin);
-        }
-        effects.add<EffectRef::FireExplosion>(
-            getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-            getgResHandlerPtr()->getTexture(
-                ResHandler::Texture::fireExplosionGlow),
-            position.x, position.y - 2);
-        killFlag = true;
+                x, y + 4, Item::Type::Coin);
+        }
+        pGame->getParticles().spawn(ParticleSystem::Kind::FireExplosion,
+                                    x, y - 2);
     }
-    Enemy::updateColor(elapsedTime);
-    hitBox.setPosition(position.x, position.y);
-    spriteSheet.setPosition(position.x, position.y);
-    shadow.setPosition(position.x - 6, position.y + 2);
     Player & player = pGame->getPlayer();
-    if (position.x > player.getXpos()) {
-        spriteSheet.setScale(1, 1);
-    } else {
-        spriteSheet.setScale(-1, 1);
-    }
-    switch (state) {
+    facingRight[i] = !(x > player.getXpos());
+    switch (getState(i)) {
     case State::drift1:
         timer += elapsedTime.asMilliseconds();
         if (timer > 1800) {
             timer -= 1800;
-            ;
-            state = State::drift2;
-            if (rng::random<2>()) {
-                changeDir(atan((position.y - player.getYpos()) /
-                               (position.x - player.getXpos())));
+            setState(i, State::drift2);
+            if (rng::random<2>(rng::Stream::ai)) {
+                changeDir(i, atan((y - player.getYpos()) /
+                                  (x - player.getXpos())));
             } else {
-                changeDir(static_cast<float>(rng::random<359>()));
+                changeDir(
+                    i, static_cast<float>(rng::random<359>(rng::Stream::ai)));
             }
         }
         break;
@@ -97,28 +171,25 @@ void Scoot::update(Game * pGame, const std::vector<wall> & w,
         timer += elapsedTime.asMilliseconds();
         if (timer > 1800) {
             timer -= 1800;
-            state = State::shoot;
+            setState(i, State::shoot);
         }
         break;
 
     case State::shoot: {
         const sf::Vector2f playerPos = player.getPosition();
-        effects.add<EffectRef::TurretFlashEffect>(
-            getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-            position.x - 8, position.y - 12);
+        pGame->getParticles().spawn(ParticleSystem::Kind::TurretFlash,
+                                    x - 8, y - 12);
         effects.add<EffectRef::TurretShot>(
-            position.x - 8, position.y - 12,
-            angleFunction(playerPos.x + 16, playerPos.y + 8, position.x - 8,
-                          position.y - 8));
-        pGame->getSounds().play(ResHandler::Sound::laser,
-                                this->shared_from_this(), 220.f, 30.f);
-        state = State::recoil;
-        changeDir(atan((position.y - player.getYpos()) /
-                       (position.x - player.getXpos())));
+            x - 8, y - 12,
+            angleFunction(playerPos.x + 16, playerPos.y + 8, x - 8, y - 8));
+        pGame->getSounds().play(ResHandler::Sound::laser, anchors[i], 220.f,
+                                30.f);
+        setState(i, State::recoil);
+        changeDir(i, atan((y - player.getYpos()) / (x - player.getXpos())));
         hSpeed *= -1;
         vSpeed *= -1;
         // Correct for negative values in arctan calculation
-        if (position.x > player.getXpos()) {
+        if (x > player.getXpos()) {
             hSpeed *= -1;
             vSpeed *= -1;
         }
@@ -130,19 +201,25 @@ void Scoot::update(Game * pGame, const std::vector<wall> & w,
         speedScale *= 0.99;
         if (timer > 400) {
             timer -= 400;
-            state = State::drift1;
+            setState(i, State::drift1);
             speedScale = 0.5f;
-            if (rng::random<2>()) {
-                changeDir(atan((position.y - player.getYpos()) /
-                               (position.x - player.getXpos())));
+            if (rng::random<2>(rng::Stream::ai)) {
+                changeDir(i, atan((y - player.getYpos()) /
+                                  (x - player.getXpos())));
             } else {
-                changeDir(rng::random<359>());
+                changeDir(i, rng::random<359>(rng::Stream::ai));
             }
         }
         break;
     }
-    uint_fast8_t collisionMask =
-        Enemy::checkWallCollision(w, position.x - 8, position.y - 8);
+    bounce(i, tiles);
+}
+
+void ScootGroup::bounce(size_t i, const tileController & tiles) {
+    float & hSpeed = kinematics.hSpeed[i];
+    float & vSpeed = kinematics.vSpeed[i];
+    uint_fast8_t collisionMask = Enemy::checkWallCollision(
+        tiles, kinematics.x[i] - 8, kinematics.y[i] - 8);
     if (collisionMask) {
         hSpeed = 0;
         vSpeed = 0;
@@ -159,17 +236,32 @@ void Scoot::update(Game * pGame, const std::vector<wall> & w,
             vSpeed -= 1;
         }
     }
-    position.x +=
-        (elapsedTime.asMicroseconds() * 0.00006f) * hSpeed * speedScale;
-    position.y +=
-        (elapsedTime.asMicroseconds() * 0.00006f) * vSpeed * speedScale;
-    frameTimer += elapsedTime.asMilliseconds();
-    if (frameTimer > 87) {
-        frameTimer -= 87;
-        frameIndex ^= 0x01;
-    }
 }
 
-const sf::Sprite & Scoot::getSprite() const { return spriteSheet[frameIndex]; }
+void ScootGroup::draw(drawableVec & gameObjects, drawableVec & gameShadows) {
+    for (size_t i = 0; i < kinematics.size(); ++i) {
+        if (!anchors[i]->isVisible()) {
+            continue;
+        }
+        const float x = kinematics.x[i];
+        const float y = kinematics.y[i];
+        shadow.setPosition(x - 6, y + 2);
+        gameShadows.emplace_back(shadow, 0.f, Rendertype::shadeDefault, 0.f);
+        sf::Sprite & sprite = spriteSheet[frameIndices[i]];
+        sprite.setPosition(x, y);
+        sprite.setScale(facingRight[i] ? -1.f : 1.f, 1.f);
+        // If the scoot should be colored, let the rendering code know to
+        // pass it through a fragment shader
+        if (kinematics.isColored(i)) {
+            gameObjects.emplace_back(sprite, y - 16, Rendertype::shadeWhite,
+                                     kinematics.colorAmount[i]);
+        } else {
+            gameObjects.emplace_back(sprite, y - 16, Rendertype::shadeDefault,
+                                     0.f);
+        }
+    }
+}
 
-const sf::Sprite & Scoot::getShadow() const { return shadow; }
+const std::vector<std::shared_ptr<Object>> & ScootGroup::getAnchors() const {
+    return anchors;
+}
@@ -3,28 +3,67 @@
 #include "RenderType.hpp"
 #include "effectsController.hpp"
 #include "enemy.hpp"
+#include "enemyKinematics.hpp"
 #include "resourceHandler.hpp"
+#include "simulationLod.hpp"
+#include "spriteSheet.hpp"
 #include "wall.hpp"
+#include <memory>
 
 class Game;
 
-class Scoot : public Enemy, public std::enable_shared_from_this<Scoot> {
+// Every scoot in the level. Scoots are nothing but their kinematics and a
+// little state machine, so they live in arrays rather than as objects, and
+// sprites are only made for the ones on screen when it's time to draw.
+// Each one still has an anchor object that follows it around, for the
+// things that keep hold of an enemy, like sounds and Laika.
+class ScootGroup {
 public:
     using HBox = HitBox<12, 12, -6, -6>;
-    Scoot(const sf::Texture &, const sf::Texture &, float, float);
-    void update(Game *, const std::vector<wall> &, const sf::Time &);
-    const sf::Sprite & getSprite() const;
-    const sf::Sprite & getShadow() const;
-    const HBox & getHitBox() const;
+    using drawableVec =
+        std::vector<std::tuple<sf::Sprite, float, Rendertype, float>>;
+    ScootGroup();
+    void add(float, float);
+    void clear();
+    // Drops the scoots killed last tick, calling onKill for each
+    template <typename F> void removeDead(const F & onKill) {
+        for (size_t i = kinematics.size(); i-- > 0;) {
+            if (kinematics.health[i] == 0) {
+                onKill();
+                removeAt(i);
+            }
+        }
+    }
+    // Updates the scoots as the lod says, and adds the positions of the ones
+    // on screen to cameraTargets. The ones just off screen drift and bounce
+    // off walls, but don't think.
+    void update(Game *, bool enabled, const tileController &,
+                const SimulationLod &,
+                std::vector<sf::Vector2f> & cameraTargets);
+    // Draws the scoots whose anchors the VisibilitySet found in view
+    void draw(drawableVec & gameObjects, drawableVec & gameShadows);
+    template <typename F> void forEachHitBox(const F & f) const {
+        HBox hitBox;
+        for (size_t i = 0; i < kinematics.size(); ++i) {
+            hitBox.setPosition(kinematics.x[i], kinematics.y[i]);
+            f(hitBox);
+        }
+    }
+    const std::vector<std::shared_ptr<Object>> & getAnchors() const;
 
 private:
-    enum class State { drift1, drift2, shoot, recoil };
-    mutable SpriteSheet<88, 161, 12, 12> spriteSheet;
+    enum class State : uint8_t { drift1, drift2, shoot, recoil };
+    State getState(size_t) const;
+    void setState(size_t, State);
+    void removeAt(size_t);
+    void think(size_t, Game *, const tileController &, const sf::Time &);
+    void changeDir(size_t, float);
+    void bounce(size_t, const tileController &);
+    EnemyKinematics kinematics;
+    std::vector<int32_t> timers, frameTimers;
+    std::vector<uint8_t> frameIndices, facingRight;
+    std::vector<std::shared_ptr<Object>> anchors;
+    // Only touched while drawing
+    SpriteSheet<88, 161, 12, 12> spriteSheet;
     sf::Sprite shadow;
-    float speedScale, hSpeed, vSpeed;
-    State state;
-    int32_t timer;
-    void changeDir(float);
-    void onDeath(EffectGroup &);
-    HBox hitBox;
 };
@@ -0,0 +1,50 @@
+#include "simulationLod.hpp"
+
+SimulationLod::SimulationLod() : tick(0), elapsedMicros(0) {}
+
+void SimulationLod::beginTick(const sf::Time & elapsedTime) {
+    ++tick;
+    elapsedMicros = elapsedTime.asMicroseconds();
+}
+
+SimulationLod::Tier SimulationLod::tierOf(Object::Proximity proximity) {
+    switch (proximity) {
+    case Object::Proximity::onScreen:
+        return Tier::full;
+
+    case Object::Proximity::visible:
+    case Object::Proximity::nearby:
+        return Tier::coarse;
+
+    default:
+        return Tier::asleep;
+    }
+}
+
+int32_t SimulationLod::step(Tier tier, int32_t & backlog,
+                            size_t index) const {
+    switch (tier) {
+    case Tier::full: {
+        const int32_t micros = elapsedMicros + backlog;
+        backlog = 0;
+        return micros;
+    }
+
+    case Tier::coarse:
+        backlog += elapsedMicros;
+        if (backlog > maxCoarseStep) {
+            backlog = maxCoarseStep;
+        }
+        if ((tick + index) % coarseInterval == 0) {
+            const int32_t micros = backlog;
+            backlog = 0;
+            return micros;
+        }
+        return 0;
+
+    case Tier::asleep:
+        break;
+    }
+    backlog = 0;
+    return 0;
+}
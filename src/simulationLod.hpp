@@ -0,0 +1,32 @@
+#pragma once
+
+#include "framework/framework.hpp"
+#include <SFML/System.hpp>
+#include <stdint.h>
+
+// Decides how much simulation each enemy gets, by how close it is to the
+// view (see VisibilitySet), so that the cost of a tick follows the number
+// of enemies near the player rather than the number in the level.
+//
+// Enemies on screen run every tick. Nearby ones run coarsely: every few
+// ticks, with the time they missed, and without attacking. Anything
+// further out sleeps, and picks up where it left off once it's nearby.
+class SimulationLod {
+public:
+    enum class Tier : uint8_t { full, coarse, asleep };
+    static const uint32_t coarseInterval = 3;
+    // Coarse enemies never catch up more than this at once, so that they
+    // don't jump through walls after a hitch
+    static const int32_t maxCoarseStep = 50000;
+    SimulationLod();
+    void beginTick(const sf::Time & elapsedTime);
+    static Tier tierOf(Object::Proximity);
+    // Returns how many microseconds to simulate an enemy for this tick, or
+    // zero to skip it. backlog holds the time the enemy has missed, and
+    // index staggers coarse enemies, so they don't all run on one tick.
+    int32_t step(Tier, int32_t & backlog, size_t index) const;
+
+private:
+    uint32_t tick;
+    int32_t elapsedMicros;
+};
@@ -5,7 +5,13 @@ static const std::string musicPaths[] = {"music/Frostellar.ogg"};
 
 SoundController::SoundController() {
     sf::Listener::setGlobalVolume(75.f);
-    currentSong.openFromFile(resourcePath() + musicPaths[0]);
+    const ResourceArchive::Blob blob =
+        getgResHandlerPtr()->getArchive().find(musicPaths[0]);
+    if (blob.data) {
+        currentSong.openFromMemory(blob.data, blob.size);
+    } else {
+        currentSong.openFromFile(resourcePath() + musicPaths[0]);
+    }
     currentSong.setLoop(true);
     currentSong.play();
 }
@@ -47,7 +53,10 @@ void SoundController::update() {
             runningSounds.back().setMinDistance(req.minDistance);
             runningSounds.back().setAttenuation(req.attenuation);
             runningData.push_back({req.source, req.spatialized});
-            if (req.spatialized) {
+            if (req.fixedPosition) {
+                runningSounds.back().setPosition(req.position.x,
+                                                 req.position.y, 0.f);
+            } else if (req.spatialized) {
                 if (auto sp = req.source.lock()) {
                     const auto pos = sp.get()->getPosition();
                     runningSounds.back().setPosition(pos.x, pos.y, 0.f);
@@ -59,8 +68,8 @@ void SoundController::update() {
                 // For some variety in looped sounds, set random playing offset
                 sf::Time loopedTrackLength =
                     runningSounds.back().getBuffer()->getDuration();
-                auto randomOffset =
-                    rng::random(loopedTrackLength.asMilliseconds());
+                auto randomOffset = rng::random(
+                    rng::Stream::audio, loopedTrackLength.asMilliseconds());
                 sf::Time playingOffset = sf::milliseconds(randomOffset);
                 runningSounds.back().setPlayingOffset(playingOffset);
                 runningSounds.back().setLoop(true);
@@ -110,3 +119,11 @@ void SoundController::play(ResHandler::Sound indx,
     soundRequests.push_back(
         {indx, minDistance, attenuation, true, loop, source});
 }
+
+void SoundController::play(ResHandler::Sound indx,
+                           const sf::Vector2f & position, float minDistance,
+                           float attenuation) {
+    std::lock_guard<std::mutex> lk(soundsGuard);
+    soundRequests.push_back({indx, minDistance, attenuation, false, false, {},
+                             true, position});
+}
@@ -15,6 +15,9 @@ struct reqInfo {
     bool spatialized;
     bool loop;
     std::weak_ptr<Object> source;
+    // For sounds that stay where they started, rather than follow a source
+    bool fixedPosition = false;
+    sf::Vector2f position{};
 };
 
 struct runningData {
@@ -38,6 +41,9 @@ public:
     // new ones will eventually use up all available sound resources.
     void play(ResHandler::Sound indx, std::shared_ptr<Object>,
               float minDistance, float attenuation, bool loop = false);
+    // For sounds whose cause doesn't outlive them, like explosions
+    void play(ResHandler::Sound indx, const sf::Vector2f & position,
+              float minDistance, float attenuation);
 
 private:
     std::mutex soundsGuard;
@@ -0,0 +1,65 @@
+#include "spriteBatch.hpp"
+#include <stdexcept>
+
+SpriteBatch::SpriteBatch(size_t quadCapacity) : batchCount(0) {
+    for (auto & batch : batches) {
+        batch.texture = nullptr;
+        batch.vertices.setPrimitiveType(sf::Quads);
+        batch.vertices.resize(quadCapacity * 4);
+        batch.vertices.clear();
+    }
+}
+
+void SpriteBatch::clear() {
+    for (size_t i = 0; i < batchCount; ++i) {
+        batches[i].vertices.clear();
+    }
+    batchCount = 0;
+}
+
+void SpriteBatch::add(const sf::Texture & texture,
+                      const sf::FloatRect & bounds,
+                      const sf::FloatRect & textureRect,
+                      const sf::Color & color) {
+    size_t i = 0;
+    while (i < batchCount && batches[i].texture != &texture) {
+        ++i;
+    }
+    if (i == batchCount) {
+        if (batchCount == maxTextures) {
+            throw std::runtime_error("sprite batch: too many textures");
+        }
+        batches[batchCount++].texture = &texture;
+    }
+    sf::VertexArray & vertices = batches[i].vertices;
+    const float left = bounds.left;
+    const float top = bounds.top;
+    const float right = bounds.left + bounds.width;
+    const float bottom = bounds.top + bounds.height;
+    const float u = textureRect.left;
+    const float v = textureRect.top;
+    const float uEnd = textureRect.left + textureRect.width;
+    const float vEnd = textureRect.top + textureRect.height;
+    vertices.append(sf::Vertex({left, top}, color, {u, v}));
+    vertices.append(sf::Vertex({right, top}, color, {uEnd, v}));
+    vertices.append(sf::Vertex({right, bottom}, color, {uEnd, vEnd}));
+    vertices.append(sf::Vertex({left, bottom}, color, {u, vEnd}));
+}
+
+size_t SpriteBatch::getBatchCount() const { return batchCount; }
+
+size_t SpriteBatch::getQuadCount() const {
+    size_t quads = 0;
+    for (size_t i = 0; i < batchCount; ++i) {
+        quads += batches[i].vertices.getVertexCount() / 4;
+    }
+    return quads;
+}
+
+void SpriteBatch::draw(sf::RenderTarget & target,
+                       sf::RenderStates states) const {
+    for (size_t i = 0; i < batchCount; ++i) {
+        states.texture = batches[i].texture;
+        target.draw(batches[i].vertices, states);
+    }
+}
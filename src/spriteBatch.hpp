@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+
+// A set of textured quads, kept in one vertex array per texture so that
+// drawing them takes one call per texture rather than one per sprite. The
+// arrays are sized up front and reused from frame to frame, so filling a
+// batch doesn't allocate unless it outgrows its capacity.
+class SpriteBatch : public sf::Drawable {
+public:
+    explicit SpriteBatch(size_t quadCapacity);
+    void clear();
+    // Adds a quad covering bounds. A negative bounds width mirrors the
+    // texture horizontally. Throws std::runtime_error if the batch already
+    // holds maxTextures other textures.
+    void add(const sf::Texture &, const sf::FloatRect & bounds,
+             const sf::FloatRect & textureRect, const sf::Color &);
+    size_t getBatchCount() const;
+    size_t getQuadCount() const;
+    static const size_t maxTextures = 4;
+
+private:
+    void draw(sf::RenderTarget &, sf::RenderStates) const override;
+    struct Batch {
+        const sf::Texture * texture;
+        sf::VertexArray vertices;
+    };
+    std::array<Batch, maxTextures> batches;
+    size_t batchCount;
+};
@@ -13,10 +13,14 @@ public:
     explicit SpriteSheet(const sf::Texture & txtr) { setTexture(txtr); }
 
     sf::Sprite & operator[](const size_t idx) {
-        sprite.setTextureRect(sf::IntRect(x + idx * w, y, w, h));
+        sprite.setTextureRect(getFrameRect(idx));
         return sprite;
     }
 
+    static sf::IntRect getFrameRect(const size_t idx) {
+        return sf::IntRect(x + idx * w, y, w, h);
+    }
+
     const sf::Vector2f & getScale() const { return sprite.getScale(); }
 
     sf::Sprite * getSpritePtr() { return &sprite; }
@@ -23,7 +23,8 @@ public:
     enum class State { dormant, wakeup, awake, poweroff };
     _Terminal(const float _xInit, const float _yInit,
               const sf::Texture & mainTxtr, const Tile tile)
-        : Object(_xInit + rng::random<4, -2>(), _yInit - rng::random<2, 1>()),
+        : Object(_xInit + rng::random<4, -2>(rng::Stream::mapgen),
+                 _yInit - rng::random<2, 1>(rng::Stream::mapgen)),
           animationTimer(0), stateTimer(0), frameIndex(0),
           state(State::dormant), screenSheet(mainTxtr), mainSprite(mainTxtr),
           shadow(mainTxtr) {
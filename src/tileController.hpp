@@ -5,10 +5,16 @@
 #include "enemyController.hpp"
 #include "resourceHandler.hpp"
 #include "wall.hpp"
+#include "levelGenerator.hpp"
+#include "mapChunks.hpp"
 #include "mappingFunctions.hpp"
+#include "tileMask.hpp"
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <cmath>
 #include <queue>
 #include <stack>
+#include <unordered_map>
 
 class tileController {
 public:
@@ -16,26 +22,70 @@ public:
     sf::Sprite transitionLvSpr;
     tileController();
     void update();
-    void draw(sf::RenderTexture &, std::vector<sf::Sprite> *, int level,
-              const sf::View &, const sf::View &);
+    // batchedGlows is drawn with the same blending as the glow sprites
+    void draw(sf::RenderTexture &, std::vector<sf::Sprite> *,
+              const sf::Drawable & batchedGlows, int level, const sf::View &,
+              const sf::View &);
     float posX;
     float posY;
     void setPosition(float, float);
     sf::RectangleShape shadow;
-    sf::Texture mapTexture[2];
-    sf::Sprite mapSprite1, mapSprite2;
+    // The map's floor and edge art, streamed in around the camera
+    MapChunks chunks;
     sf::RenderTexture rt, re;
-    Tile mapArray[61][61];
+    TileMap mapArray;
+    // Rebuilt with the map, empty for the intro
+    TileMask tileMask;
     std::vector<wall> walls;
+    // Buckets the walls by map chunk, and within a chunk by tile, call after
+    // changing walls
+    void indexWalls();
+    // Calls f with the position of each wall whose top left corner lies in
+    // area. Only the tiles under area are looked at, so the cost doesn't grow
+    // with the size of the map.
+    template <typename F>
+    void forEachWallIn(const sf::FloatRect & area, F && f) const {
+        const int left = std::floor((area.left - posX) / 32) - 1;
+        const int right = std::floor((area.left + area.width - posX) / 32) + 1;
+        const int top = std::floor((area.top - posY) / 26) - 1;
+        const int bottom =
+            std::floor((area.top + area.height - posY) / 26) + 1;
+        for (int x = left; x <= right; x++) {
+            for (int y = top; y <= bottom; y++) {
+                const std::vector<sf::Vector2f> * cell = wallsAt(x, y);
+                if (!cell) {
+                    continue;
+                }
+                for (const auto & wallInit : *cell) {
+                    const sf::Vector2f position(wallInit.x + posX,
+                                                wallInit.y + posY);
+                    if (area.contains(position)) {
+                        f(position);
+                    }
+                }
+            }
+        }
+    }
     std::vector<Coordinate> emptyMapLocations;
     Coordinate teleporterLocation;
     Coordinate getTeleporterLoc();
     void clear();
-    // A function to rebuild map vectors
-    void rebuild(Tileset);
+    // A function to rebuild map vectors, the layout and art are ignored for
+    // the intro
+    void rebuild(Tileset, const LevelLayout &, MapChunks::Prepared && art);
     std::vector<Coordinate> * getEmptyLocations();
     float getPosX() const;
     float getPosY() const;
     void setWindowSize(float, float);
     void reset();
+
+private:
+    // Initial wall positions, by tile, for one map chunk
+    struct WallChunk {
+        std::array<std::vector<sf::Vector2f>, MapChunks::size * MapChunks::size>
+            cells;
+    };
+    // Returns the walls in tile x, y, or null if its chunk has none
+    const std::vector<sf::Vector2f> * wallsAt(int x, int y) const;
+    std::unordered_map<uint64_t, WallChunk> wallChunks;
 };
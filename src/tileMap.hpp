@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Tile.hpp"
+#include <cstddef>
+#include <vector>
+
+// A two dimensional array sized at runtime. Cells are stored column by
+// column, the same order as a T[width][height] array, so (x, y) sits next to
+// (x, y + 1) in memory.
+template <typename T> class Grid {
+public:
+    Grid() : width(0), height(0) {}
+    Grid(int width, int height, T value = T()) { resize(width, height, value); }
+    // Throws away the old contents
+    void resize(int width, int height, T value = T()) {
+        this->width = width;
+        this->height = height;
+        cells.assign(static_cast<size_t>(width) * height, value);
+    }
+    void fill(T value) { cells.assign(cells.size(), value); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool contains(int x, int y) const {
+        return static_cast<unsigned>(x) < static_cast<unsigned>(width) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(height);
+    }
+    T & operator()(int x, int y) { return cells[x * height + y]; }
+    const T & operator()(int x, int y) const { return cells[x * height + y]; }
+    // Like operator(), but cells outside of the grid read as outside
+    T get(int x, int y, T outside = T()) const {
+        return contains(x, y) ? (*this)(x, y) : outside;
+    }
+    const T * data() const { return cells.data(); }
+    size_t size() const { return cells.size(); }
+
+private:
+    int width;
+    int height;
+    std::vector<T> cells;
+};
+
+// Tile() is Tile::Empty, so tiles outside of a map read as empty
+using TileMap = Grid<Tile>;
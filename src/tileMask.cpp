@@ -0,0 +1,27 @@
+#include "tileMask.hpp"
+
+TileMask::TileMask() : width(0), height(0) {}
+
+void TileMask::rebuild(const TileMap & map) {
+    width = map.getWidth();
+    height = map.getHeight();
+    const size_t words = (map.size() + 63) / 64;
+    walkable.assign(words, 0);
+    walls.assign(words, 0);
+    const Tile * tiles = map.data();
+    for (size_t i = 0; i < map.size(); i++) {
+        const uint64_t bit = uint64_t(1) << (i % 64);
+        if (isTileWalkable(tiles[i])) {
+            walkable[i / 64] |= bit;
+        } else if (isTileWall(tiles[i])) {
+            walls[i / 64] |= bit;
+        }
+    }
+}
+
+void TileMask::clear() {
+    width = 0;
+    height = 0;
+    walkable.clear();
+    walls.clear();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "mappingFunctions.hpp"
+#include "tileMap.hpp"
+#include <stdint.h>
+#include <vector>
+
+// One bit per tile for the questions that get asked about a level's tiles
+// over and over, like whether an enemy can step somewhere. Bits follow the
+// map's column by column order. Tiles outside of the map are neither
+// walkable nor walls.
+class TileMask {
+public:
+    TileMask();
+    void rebuild(const TileMap & map);
+    void clear();
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool isWalkable(int x, int y) const { return test(walkable, x, y); }
+    bool isWall(int x, int y) const { return test(walls, x, y); }
+
+private:
+    bool test(const std::vector<uint64_t> & bits, int x, int y) const {
+        if (static_cast<unsigned>(x) >= static_cast<unsigned>(width) ||
+            static_cast<unsigned>(y) >= static_cast<unsigned>(height)) {
+            return false;
+        }
+        const size_t index = static_cast<size_t>(x) * height + y;
+        return (bits[index / 64] >> (index % 64)) & 1;
+    }
+    int width;
+    int height;
+    std::vector<uint64_t> walkable;
+    std::vector<uint64_t> walls;
+};
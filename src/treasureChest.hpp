@@ -16,8 +16,8 @@ public:
     enum class State { closed, opening, ready, complete };
     _TreasureChest(float _xInit, float _yInit, const sf::Texture & mainTxtr,
                    Powerup _powerup)
-        : Object(_xInit + rng::random<4, -2>(), _yInit), state(State::closed),
-          powerup(_powerup), animationTimer(0), frameIndex(0),
+        : Object(_xInit + rng::random<4, -2>(rng::Stream::mapgen), _yInit),
+          state(State::closed), powerup(_powerup), animationTimer(0), frameIndex(0),
           chestSheet(mainTxtr) {
         chestShadow.setTexture(mainTxtr);
         chestShadow.setTextureRect(sf::IntRect(18, 107, 16, 8));
@@ -4,77 +4,135 @@
 #include "player.hpp"
 #include <cmath>
 
-Turret::Turret(const sf::Texture & gameObjects, float _xPos, float _yPos)
-    : Enemy(_xPos, _yPos), state(State::closed), frameIndex(0), timer(0), hp(6),
-      colorTimer(0), isColored(0), colorAmount(0) {
+TurretGroup::TurretGroup() {
+    const sf::Texture & gameObjects =
+        getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects);
     turretSheet.setTexture(gameObjects);
     shadowSheet.setTexture(gameObjects);
-    hitBox.setPosition(position.x, position.y);
-    turretSheet.setPosition(position.x, position.y);
-    shadowSheet.setPosition(position.x, position.y + 18);
-    hitBox.setPosition(position.x, position.y);
 }
 
-const sf::Sprite & Turret::getSprite() { return turretSheet[frameIndex]; }
+void TurretGroup::add(float x, float y) {
+    kinematics.add(x, y, 0.f, 0.f, 6);
+    setState(kinematics.size() - 1, State::closed);
+    timers.push_back(0);
+    frameIndices.push_back(0);
+    targets.emplace_back();
+    anchors.push_back(std::make_shared<Object>(x, y));
+}
 
-void Turret::update(const sf::Time & elapsedTime, Game * pGame) {
-    EffectGroup & effects = pGame->getEffects();
-    Player & player = pGame->getPlayer();
-    if (isColored) {
-        colorTimer += elapsedTime.asMilliseconds();
-        if (colorTimer > 20.f) {
-            colorTimer -= 20.f;
-            colorAmount -= 0.1f;
+void TurretGroup::clear() {
+    kinematics.clear();
+    timers.clear();
+    frameIndices.clear();
+    targets.clear();
+    anchors.clear();
+}
+
+template <typename T> static void removeAt(std::vector<T> & vec, size_t index) {
+    vec[index] = std::move(vec.back());
+    vec.pop_back();
+}
+
+void TurretGroup::removeAt(size_t index) {
+    anchors[index]->setKillFlag();
+    kinematics.removeAt(index);
+    ::removeAt(timers, index);
+    ::removeAt(frameIndices, index);
+    ::removeAt(targets, index);
+    ::removeAt(anchors, index);
+}
+
+TurretGroup::State TurretGroup::getState(size_t index) const {
+    return static_cast<State>(kinematics.state[index]);
+}
+
+void TurretGroup::setState(size_t index, State state) {
+    kinematics.state[index] = static_cast<uint8_t>(state);
+}
+
+void TurretGroup::update(Game * pGame, bool enabled, const SimulationLod & lod,
+                         std::vector<sf::Vector2f> & cameraTargets) {
+    const size_t count = kinematics.size();
+    if (enabled) {
+        for (size_t i = 0; i < count; ++i) {
+            kinematics.tier[i] =
+                SimulationLod::tierOf(anchors[i]->getProximity());
+        }
+        kinematics.schedule(lod);
+        for (size_t i = 0; i < count; ++i) {
+            if (kinematics.step[i]) {
+                think(i, pGame, sf::microseconds(kinematics.step[i]),
+                      kinematics.tier[i] == SimulationLod::Tier::coarse);
+            }
         }
-        if (colorAmount <= 0.f) {
-            isColored = false;
+        kinematics.decayColor();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (anchors[i]->isOnScreen()) {
+            cameraTargets.emplace_back(kinematics.x[i], kinematics.y[i]);
         }
     }
+}
+
+static bool inRange(float x, float y, const Player & player) {
+    return std::sqrt(std::pow((x - player.getXpos() + 8), 2) +
+                     std::pow((y - player.getYpos() + 16), 2)) < 174;
+}
+
+// Everything but fading the hit flash, which update() does for all of the
+// turrets at once afterwards
+void TurretGroup::think(size_t i, Game * pGame, const sf::Time & elapsedTime,
+                        bool coarse) {
+    const float x = kinematics.x[i];
+    const float y = kinematics.y[i];
+    uint8_t & health = kinematics.health[i];
+    int32_t & timer = timers[i];
+    int8_t & frameIndex = frameIndices[i];
+    EffectGroup & effects = pGame->getEffects();
+    Player & player = pGame->getPlayer();
+    HBox hitBox;
+    hitBox.setPosition(x, y);
     for (auto & element : effects.get<EffectRef::PlayerShot>()) {
-        if (hitBox.overlapping(element->getHitBox()) &&
+        // A turret that's already destroyed waits to be removed, rather than
+        // letting a second shot wrap its health around
+        if (health && hitBox.overlapping(element->getHitBox()) &&
             element->checkCanPoof()) {
-            if (hp == 1) {
+            if (health == 1) {
                 element->disablePuff();
                 element->setKillFlag();
             }
             element->poof();
-            hp -= 1;
-            isColored = true;
-            colorAmount = 1.f;
+            health -= 1;
+            kinematics.colorAmount[i] = 1.f;
         }
     }
     for (auto & helper : pGame->getHelperGroup().get<HelperRef::Laika>()) {
         if (hitBox.overlapping(helper->getHitBox())) {
-            hp = 0;
+            health = 0;
         }
     }
-    if (hp == 0) {
-        killFlag = true;
-        if (rng::random<4>() == 0) {
+    if (health == 0) {
+        if (rng::random<4>(rng::Stream::ai) == 0) {
             effects.add<EffectRef::Heart>(
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
                 getgResHandlerPtr()->getTexture(ResHandler::Texture::redglow),
-                position.x + 8, position.y + 10, Item::Type::Heart);
+                x + 8, y + 10, Item::Type::Heart);
         } else {
             effects.add<EffectRef::Coin>(
                 getgResHandlerPtr()->getTexture(
                     ResHandler::Texture::gameObjects),
                 getgResHandlerPtr()->getTexture(ResHandler::Texture::blueglow),
-                position.x + 8, position.y + 10, Item::Type::Coin);
+                x + 8, y + 10, Item::Type::Coin);
         }
-        effects.add<EffectRef::FireExplosion>(
-            getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
-            getgResHandlerPtr()->getTexture(
-                ResHandler::Texture::fireExplosionGlow),
-            position.x + 12, position.y + 12);
+        pGame->getParticles().spawn(ParticleSystem::Kind::FireExplosion,
+                                    x + 12, y + 12);
+        return;
     }
-    switch (state) {
+    switch (getState(i)) {
     case State::closed:
-        if (std::sqrt(std::pow((position.x - player.getXpos() + 8), 2) +
-                      std::pow((position.y - player.getYpos() + 16), 2)) <
-            174) {
-            state = State::opening;
+        if (!coarse && inRange(x, y, player)) {
+            setState(i, State::opening);
             timer = 0;
             frameIndex = 0;
         }
@@ -87,78 +145,54 @@ void Turret::update(const sf::Time & elapsedTime, Game * pGame) {
             frameIndex += 1;
             if (frameIndex > 4) {
                 frameIndex = 4;
-                state = State::shoot1;
+                setState(i, State::shoot1);
             }
         }
         break;
 
+    // A coarse turret goes through its volley without firing, so that the
+    // volley takes as long as it would on screen
     case State::shoot1:
-        target = player.getPosition();
+        targets[i] = player.getPosition();
         timer += elapsedTime.asMicroseconds();
         if (timer > 200000) {
-            effects.add<EffectRef::TurretFlashEffect>(
-                getgResHandlerPtr()->getTexture(
-                    ResHandler::Texture::gameObjects),
-                position.x, position.y + 8);
-            effects.add<EffectRef::EnemyShot>(
-                getgResHandlerPtr()->getTexture(
-                    ResHandler::Texture::gameObjects),
-                getgResHandlerPtr()->getTexture(ResHandler::Texture::redglow),
-                position.x, position.y + 6,
-                angleFunction(target.x + 16, target.y + 8, position.x + 18,
-                              position.y + 8));
+            if (!coarse) {
+                fire(i, pGame, 6, 8);
+            }
             timer = 0;
-            state = State::shoot2;
+            setState(i, State::shoot2);
         }
         break;
 
     case State::shoot2:
         timer += elapsedTime.asMicroseconds();
         if (timer > 200000) {
-            effects.add<EffectRef::TurretFlashEffect>(
-                getgResHandlerPtr()->getTexture(
-                    ResHandler::Texture::gameObjects),
-                position.x, position.y + 8);
-            effects.add<EffectRef::EnemyShot>(
-                getgResHandlerPtr()->getTexture(
-                    ResHandler::Texture::gameObjects),
-                getgResHandlerPtr()->getTexture(ResHandler::Texture::redglow),
-                position.x, position.y + 8,
-                angleFunction(target.x + 16, target.y + 8, position.x + 18,
-                              position.y + 6));
+            if (!coarse) {
+                fire(i, pGame, 8, 6);
+            }
             timer = 0;
-            state = State::shoot3;
+            setState(i, State::shoot3);
         }
         break;
 
     case State::shoot3:
         timer += elapsedTime.asMicroseconds();
         if (timer > 200000) {
-            effects.add<EffectRef::TurretFlashEffect>(
-                getgResHandlerPtr()->getTexture(
-                    ResHandler::Texture::gameObjects),
-                position.x, position.y + 8);
-            effects.add<EffectRef::EnemyShot>(
-                getgResHandlerPtr()->getTexture(
-                    ResHandler::Texture::gameObjects),
-                getgResHandlerPtr()->getTexture(ResHandler::Texture::redglow),
-                position.x, position.y + 8,
-                angleFunction(target.x + 16, target.y + 8, position.x + 18,
-                              position.y + 6));
+            if (!coarse) {
+                fire(i, pGame, 8, 6);
+            }
             timer = 0;
-            state = State::rest;
+            setState(i, State::rest);
         }
         break;
 
     case State::rest:
         timer += elapsedTime.asMicroseconds();
         if (timer > 1200000) {
-            if (std::sqrt(std::pow((position.x - player.getXpos() + 8), 2) +
-                          std::pow((position.y - player.getYpos() + 16), 2)) <
-                174) {
-                state = State::shoot1;
+            if (inRange(x, y, player)) {
+                setState(i, State::shoot1);
             } else {
-                state = State::closing;
+                setState(i, State::closing);
             }
             timer = 0;
         }
@@ -171,15 +205,46 @@ void Turret::update(const sf::Time & elapsedTime, Game * pGame) {
             frameIndex -= 1;
             if (frameIndex < 0) {
                 frameIndex = 0;
-                state = State::closed;
+                setState(i, State::closed);
             }
         }
         break;
     }
 }
 
-const Turret::HBox & Turret::getHitBox() const { return hitBox; }
+void TurretGroup::fire(size_t i, Game * pGame, float shotYOffset,
+                       float aimYOffset) {
+    const float x = kinematics.x[i];
+    const float y = kinematics.y[i];
+    const sf::Vector2f & target = targets[i];
+    pGame->getParticles().spawn(ParticleSystem::Kind::TurretFlash, x, y + 8);
+    pGame->getEffects().add<EffectRef::EnemyShot>(
+        getgResHandlerPtr()->getTexture(ResHandler::Texture::gameObjects),
+        getgResHandlerPtr()->getTexture(ResHandler::Texture::redglow), x,
+        y + shotYOffset,
+        angleFunction(target.x + 16, target.y + 8, x + 18, y + aimYOffset));
+}
 
-const sf::Sprite & Turret::getShadow() { return shadowSheet[frameIndex]; }
+void TurretGroup::draw(drawableVec & gameObjects, drawableVec & gameShadows) {
+    for (size_t i = 0; i < kinematics.size(); ++i) {
+        if (!anchors[i]->isVisible()) {
+            continue;
+        }
+        const float x = kinematics.x[i];
+        const float y = kinematics.y[i];
+        sf::Sprite & shadow = shadowSheet[frameIndices[i]];
+        shadow.setPosition(x, y + 18);
+        gameShadows.emplace_back(shadow, 0.f, Rendertype::shadeDefault, 0.f);
+        sf::Sprite & sprite = turretSheet[frameIndices[i]];
+        sprite.setPosition(x, y);
+        if (kinematics.isColored(i)) {
+            gameObjects.emplace_back(sprite, y, Rendertype::shadeWhite, 0.f);
+        } else {
+            gameObjects.emplace_back(sprite, y, Rendertype::shadeDefault, 0.f);
+        }
+    }
+}
 
-bool Turret::colored() { return isColored; }
+const std::vector<std::shared_ptr<Object>> & TurretGroup::getAnchors() const {
+    return anchors;
+}
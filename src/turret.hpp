@@ -1,40 +1,67 @@
 #pragma once
 
+#include "RenderType.hpp"
 #include "effectsController.hpp"
 #include "enemy.hpp"
-#include "framework/framework.hpp"
+#include "enemyKinematics.hpp"
 #include "resourceHandler.hpp"
+#include "simulationLod.hpp"
 #include "spriteSheet.hpp"
-#include "turret.hpp"
 #include <SFML/Graphics.hpp>
-#include <stdio.h>
+#include <memory>
 
 class Game;
 
-class Turret : public Enemy {
-private:
-    enum class State { closed, opening, shoot1, shoot2, shoot3, rest, closing };
-    State state;
+// Every turret in the level, laid out like ScootGroup. Turrets never move,
+// so only their health, hit flash and state machine are simulated, and each
+// has an anchor object for Laika to find it by.
+class TurretGroup {
+public:
     using HBox = HitBox<16, 32>;
-    HBox hitBox;
-    int8_t frameIndex;
+    using drawableVec =
+        std::vector<std::tuple<sf::Sprite, float, Rendertype, float>>;
+    TurretGroup();
+    void add(float, float);
+    void clear();
+    // Drops the turrets destroyed last tick, calling onKill for each
+    template <typename F> void removeDead(const F & onKill) {
+        for (size_t i = kinematics.size(); i-- > 0;) {
+            if (kinematics.health[i] == 0) {
+                onKill();
+                removeAt(i);
+            }
+        }
+    }
+    // Updates the turrets as the lod says, and adds the positions of the
+    // ones on screen to cameraTargets. A coarse update keeps a turret's
+    // timers running, but never opens it or fires.
+    void update(Game *, bool enabled, const SimulationLod &,
+                std::vector<sf::Vector2f> & cameraTargets);
+    // Draws the turrets whose anchors the VisibilitySet found in view
+    void draw(drawableVec & gameObjects, drawableVec & gameShadows);
+    const std::vector<std::shared_ptr<Object>> & getAnchors() const;
+
+private:
+    enum class State : uint8_t {
+        closed,
+        opening,
+        shoot1,
+        shoot2,
+        shoot3,
+        rest,
+        closing
+    };
+    State getState(size_t) const;
+    void setState(size_t, State);
+    void removeAt(size_t);
+    void think(size_t, Game *, const sf::Time &, bool coarse);
+    void fire(size_t, Game *, float shotYOffset, float aimYOffset);
+    EnemyKinematics kinematics;
+    std::vector<int32_t> timers;
+    std::vector<int8_t> frameIndices;
+    std::vector<sf::Vector2f> targets;
+    std::vector<std::shared_ptr<Object>> anchors;
+    // Only touched while drawing
     SpriteSheet<0, 0, 16, 32> turretSheet;
     SpriteSheet<0, 32, 16, 26> shadowSheet;
-    bool active;
-    int64_t timer;
-    float hp;
-    char colorTimer;
-    bool isColored;
-    float colorAmount;
-
-public:
-    Turret(const sf::Texture &, float, float);
-    const HBox & getHitBox() const;
-    void setPosition(float, float);
-    const sf::Sprite & getShadow();
-    const sf::Sprite & getSprite();
-    sf::Vector2f target;
-    void update(const sf::Time &, Game *);
-    bool colored();
-    float getColorAmount();
 };
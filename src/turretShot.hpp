@@ -52,7 +52,7 @@ public:
         if (timer > lifetime) {
             setKillFlag();
         }
-        float offset = rng::random<20>();
+        float offset = rng::random<20>(rng::Stream::fx);
         glowSprite.setColor(
             sf::Color(230 + offset, 230 + offset, 230 + offset, 255));
         animationTimer += elapsedTime.asMilliseconds();
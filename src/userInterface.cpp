@@ -315,7 +315,7 @@ void ui::Backend::update(Game * pGame, const sf::Time & elapsedTime) {
             hg.add<HelperRef::Laika>(playerPos.x, playerPos.y + 32,
                                      getgResHandlerPtr()->getTexture(
                                          ResHandler::Texture::gameObjects),
-                                     pGame->getTileController().mapArray);
+                                     pGame->getTileController().tileMask);
         } break;
         }
         powerupBubbleState = PowerupBubbleState::dormant;
@@ -0,0 +1,29 @@
+#include "visibility.hpp"
+#include "enemyKinematics.hpp"
+
+void VisibilitySet::begin() {
+    // clear() keeps the capacity, so the storage is reused tick to tick
+    objects.clear();
+}
+
+void VisibilitySet::insert(Object & object) {
+    object.setProximity(Object::Proximity::distant);
+    objects.push_back(&object);
+}
+
+void VisibilitySet::build(const sf::View & view) {
+    const ViewBounds nearby(view, nearbyMargin);
+    const ViewBounds visible(view, drawMargin);
+    const ViewBounds screen(view, screenMargin);
+    for (Object * object : objects) {
+        const float x = object->getPosition().x;
+        const float y = object->getPosition().y;
+        if (screen.contains(x, y)) {
+            object->setProximity(Object::Proximity::onScreen);
+        } else if (visible.contains(x, y)) {
+            object->setProximity(Object::Proximity::visible);
+        } else if (nearby.contains(x, y)) {
+            object->setProximity(Object::Proximity::nearby);
+        }
+    }
+}
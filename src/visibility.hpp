@@ -0,0 +1,36 @@
+#pragma once
+
+#include "framework/framework.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Works out once a tick which objects are near the camera, so that the
+// enemy culling, Laika's targeting and the draw code all read the same
+// answer instead of each testing every object against the view. It's a
+// single pass over the objects: a level holds too few for a spatial index to
+// pay for itself. The result is left on the objects themselves, see
+// Object::getProximity().
+class VisibilitySet {
+public:
+    // Objects this close to the view are drawn
+    static constexpr float drawMargin = 128.f;
+    // Enemies this close to the view are updated, and followed by the camera
+    static constexpr float screenMargin = 32.f;
+    // Enemies this close to the view keep simulating, coarsely, see
+    // SimulationLod. Past it they sleep.
+    static constexpr float nearbyMargin = 224.f;
+    // Empties the set, call before inserting this tick's objects
+    void begin();
+    // Also marks the object distant, until build() says otherwise
+    void insert(Object &);
+    template <typename Container> void insertAll(const Container & objects) {
+        for (auto & element : objects) {
+            insert(*element);
+        }
+    }
+    // Flags the objects inserted since begin() by their distance to view
+    void build(const sf::View & view);
+
+private:
+    std::vector<Object *> objects;
+};
@@ -0,0 +1,482 @@
+// mapbench: checks generateMap() against the original tile by tile
+// implementation, then measures how many levels per second each produces.
+// Does the same for rock and lamp placement, over generated maps.
+//
+//   mapbench [LEVELS]
+//
+// A level is timed the way Game::nextLevel() builds it, retrying until the
+// map has at least 150 center tiles, and generateMap() itself retries its
+// overlay until it has 300 plates, so both rejection loops are included.
+
+#include "../src/levelGenerator.hpp"
+#include "../src/lightingMap.hpp"
+#include "../src/mappingFunctions.hpp"
+#include "../src/pillarPlacement.h"
+#include "../src/rng.hpp"
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stack>
+#include <utility>
+
+// The scalar implementation generateMap() replaced, kept as a reference
+namespace reference {
+static void floodFill(Tile map[MAP_WIDTH][MAP_HEIGHT], size_t x, size_t y,
+                      Tile sub) {
+    using Coord = std::pair<size_t, size_t>;
+    std::stack<Coord> stack;
+    stack.push({x, y});
+    Tile target = map[x][y];
+    const auto action = [map, target, sub, &stack](Coord & c, int xOff,
+                                                   int yOff) {
+        const int i = c.first + xOff;
+        const int j = c.second + yOff;
+        if (i > 0 && i < MAP_WIDTH - 1 && j > 0 && j < MAP_HEIGHT - 1) {
+            if (map[i][j] == target) {
+                map[i][j] = sub;
+                stack.push({i, j});
+            }
+        }
+    };
+    while (!stack.empty()) {
+        Coord coord = stack.top();
+        stack.pop();
+        action(coord, -1, 0);
+        action(coord, 0, 1);
+        action(coord, 0, -1);
+        action(coord, 1, 0);
+    }
+}
+
+static void renumber(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    for (int i = 0; i < MAP_WIDTH; i++) {
+        for (int j = 0; j < MAP_HEIGHT; j++) {
+            if (map[i][j] == Tile::Wall) {
+                map[i][j] = Tile::_UNUSED1_;
+            } else if (map[i][j] == Tile::Empty) {
+                map[i][j] = Tile::Wall;
+            }
+        }
+    }
+}
+
+static void addEdges(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    for (int i = 0; i < MAP_WIDTH; i++) {
+        for (int j = 0; j < MAP_HEIGHT; j++) {
+            if (map[i][j] == Tile::Wall) {
+                if (map[i][j - 1] == Tile::Plate) {
+                    if (map[i][j + 1] != Tile::Plate) {
+                        map[i][j] = Tile::PlateLowerEdge;
+                    } else {
+                        map[i][j] = Tile::Plate;
+                    }
+                } else if (map[i][j + 1] == Tile::Plate) {
+                    map[i][j] = Tile::PlateUpperEdge;
+                }
+            }
+        }
+    }
+}
+
+static void addCenterTiles(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    for (int i = 0; i < MAP_WIDTH; i++) {
+        for (int j = 0; j < MAP_HEIGHT; j++) {
+            if ((map[i - 1][j] == Tile::Plate || map[i - 1][j] == Tile::Sand ||
+                 map[i - 1][j] == Tile::SandAndGrass) &&
+                (map[i + 1][j] == Tile::Plate || map[i + 1][j] == Tile::Sand ||
+                 map[i + 1][j] == Tile::SandAndGrass) &&
+                (map[i][j - 1] == Tile::Plate || map[i][j - 1] == Tile::Sand ||
+                 map[i][j - 1] == Tile::SandAndGrass) &&
+                (map[i][j + 1] == Tile::Plate || map[i][j + 1] == Tile::Sand ||
+                 map[i][j + 1] == Tile::SandAndGrass)) {
+                if (rng::random<12>(rng::Stream::mapgen) > 2) {
+                    map[i][j] = Tile::Sand;
+                } else {
+                    map[i][j] = Tile::SandAndGrass;
+                }
+            }
+        }
+    }
+}
+
+static void condense(Tile map[MAP_WIDTH][MAP_HEIGHT],
+                     Tile maptemp[MAP_WIDTH][MAP_HEIGHT], int rep) {
+    for (int i = 2; i < MAP_WIDTH - 2; i++) {
+        for (int j = 2; j < MAP_HEIGHT - 2; j++) {
+            uint8_t count = 0;
+            for (int di = -1; di <= 1; di++) {
+                for (int dj = -1; dj <= 1; dj++) {
+                    if ((di || dj) && map[i + di][j + dj] == Tile::Wall) {
+                        count += 1;
+                    }
+                }
+            }
+            if (map[i][j] == Tile::Wall) {
+                maptemp[i][j] = count < 2 ? Tile::Empty : Tile::Wall;
+            } else {
+                maptemp[i][j] = count > 5 ? Tile::Wall : Tile::Empty;
+            }
+        }
+    }
+    for (int i = 2; i < MAP_WIDTH - 2; i++) {
+        for (int j = 2; j < MAP_HEIGHT - 2; j++) {
+            map[i][j] = maptemp[i][j];
+        }
+    }
+    if (rep > 0) {
+        condense(map, maptemp, rep - 1);
+    }
+}
+
+static int initMapOverlay(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    Tile maptemp[MAP_WIDTH][MAP_HEIGHT];
+    std::memset(map, 0, sizeof(Tile) * MAP_WIDTH * MAP_HEIGHT);
+    std::memset(maptemp, 0, sizeof(Tile) * MAP_WIDTH * MAP_HEIGHT);
+    for (int i = MAP_MARGIN; i < MAP_WIDTH - MAP_MARGIN; i++) {
+        for (int j = MAP_MARGIN; j < MAP_WIDTH - MAP_MARGIN; j++) {
+            map[i][j] = static_cast<Tile>(rng::random<2>(rng::Stream::mapgen));
+        }
+    }
+    condense(map, maptemp, 3);
+    uint8_t xindex;
+    uint8_t yindex;
+    do {
+        xindex = rng::random<MAP_WIDTH>(rng::Stream::mapgen);
+        yindex = rng::random<MAP_HEIGHT>(rng::Stream::mapgen);
+    } while (map[xindex][yindex] != Tile::Wall);
+    floodFill(map, xindex, yindex, Tile::Plate);
+    int count = 0;
+    for (int i = 0; i < MAP_WIDTH - 2; i++) {
+        for (int j = 0; j < MAP_HEIGHT - 2; j++) {
+            if (map[i][j] == Tile::Plate) {
+                count += 1;
+            }
+        }
+    }
+    return count;
+}
+
+static void combine(Tile map[MAP_WIDTH][MAP_HEIGHT],
+                    Tile overlay[MAP_WIDTH][MAP_HEIGHT]) {
+    for (int i = 0; i < MAP_WIDTH; i++) {
+        for (int j = 0; j < MAP_HEIGHT; j++) {
+            if (overlay[i][j] == Tile::Plate && map[i][j] != Tile::Empty &&
+                map[i][j] != Tile::Wall) {
+                if (map[i][j] == Tile::PlateLowerEdge) {
+                    map[i][j] = Tile::GrassLowerEdge;
+                } else if (map[i][j] == Tile::PlateUpperEdge) {
+                    map[i][j] = Tile::GrassUpperEdge;
+                } else if (map[i][j] == Tile::Plate) {
+                    map[i][j] = Tile::Grass;
+                } else {
+                    map[i][j] = Tile::GrassFlowers;
+                }
+            }
+        }
+    }
+}
+
+static void cleanEdgesPostCombine(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    for (int i = 1; i < MAP_WIDTH - 1; i++) {
+        for (int j = 1; j < MAP_HEIGHT - 1; j++) {
+            if (map[i][j] == Tile::GrassLowerEdge &&
+                map[i][j - 1] != Tile::Grass) {
+                map[i][j] = Tile::PlateLowerEdge;
+            } else if (map[i][j] == Tile::GrassUpperEdge &&
+                       map[i][j + 1] != Tile::Grass) {
+                map[i][j] = Tile::PlateUpperEdge;
+            }
+        }
+    }
+}
+
+static int generateMap(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    Tile maptemp[MAP_WIDTH][MAP_HEIGHT];
+    std::memset(map, 0, sizeof(Tile) * MAP_WIDTH * MAP_HEIGHT);
+    std::memset(maptemp, 0, sizeof(Tile) * MAP_WIDTH * MAP_HEIGHT);
+    for (int i = MAP_MARGIN; i < MAP_WIDTH - MAP_MARGIN; i++) {
+        for (int j = MAP_MARGIN; j < MAP_HEIGHT - MAP_MARGIN; j++) {
+            map[i][j] = static_cast<Tile>(rng::random<2>(rng::Stream::mapgen));
+        }
+    }
+    condense(map, maptemp, 1);
+    renumber(map);
+    uint8_t xindex;
+    uint8_t yindex;
+    do {
+        xindex = rng::random<MAP_WIDTH>(rng::Stream::mapgen);
+        yindex = rng::random<MAP_HEIGHT>(rng::Stream::mapgen);
+    } while (map[xindex][yindex] != Tile::_UNUSED1_);
+    floodFill(map, xindex, yindex, Tile::Plate);
+    for (int i = 2; i < MAP_WIDTH - 2; i++) {
+        for (int j = 2; j < MAP_HEIGHT - 2; j++) {
+            if (map[i][j] == Tile::_UNUSED1_) {
+                map[i][j] = Tile::Wall;
+            }
+        }
+    }
+    addEdges(map);
+    addCenterTiles(map);
+    int count = 0;
+    for (int i = 0; i < MAP_WIDTH - 2; i++) {
+        for (int j = 0; j < MAP_HEIGHT - 2; j++) {
+            if (map[i][j] == Tile::Sand || map[i][j] == Tile::SandAndGrass) {
+                count += 1;
+            }
+            if (map[i + 1][j] == Tile::Plate && map[i - 1][j] == Tile::Plate &&
+                map[i][j + 1] == Tile::Plate && map[i][j - 1] == Tile::Plate) {
+                map[i][j] = Tile::Plate;
+            }
+        }
+    }
+    Tile mapOverlay[MAP_WIDTH][MAP_HEIGHT];
+    int count2;
+    do {
+        count2 = initMapOverlay(mapOverlay);
+    } while (count2 < 300);
+    combine(map, mapOverlay);
+    cleanEdgesPostCombine(map);
+    return count;
+}
+
+// The erase based placement selectSpacedCircles() replaced
+static bool sqrtOverlap(Circle c1, Circle c2) {
+    double centerDifference =
+        sqrt((double)(32 * (c1.x - c2.x)) * (32 * (c1.x - c2.x)) +
+             (26 * (c1.y - c2.y)) * (26 * (c1.y - c2.y)));
+    if (centerDifference <= (double)c1.r || centerDifference <= (double)c2.r) {
+        return true;
+    }
+    return false;
+}
+
+static void placeCircles(const TileMap & gameMap,
+                         std::vector<Coordinate> & availableLocations,
+                         Circle & teleporterFootprint,
+                         rng::Generator & generator, int radius, int spread,
+                         bool onGrass) {
+    std::vector<Circle> circleMap;
+    for (int i = 0; i < 61; i++) {
+        for (int j = 0; j < 61; j++) {
+            Circle c;
+            if (gameMap(i, j) == Tile::Sand ||
+                gameMap(i, j) == Tile::SandAndGrass ||
+                (onGrass && (gameMap(i, j) == Tile::Grass ||
+                             gameMap(i, j) == Tile::GrassFlowers))) {
+                c.x = i;
+                c.y = j;
+                c.r = radius + rng::random(generator, spread);
+                circleMap.push_back(c);
+            }
+        }
+    }
+    for (auto it = circleMap.begin(); it != circleMap.end();) {
+        if (sqrtOverlap(teleporterFootprint, *it)) {
+            it = circleMap.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    size_t length = circleMap.size();
+    std::shuffle(circleMap.begin(), circleMap.end(), generator);
+    for (size_t i = 0; i < length; i++) {
+        for (auto it = circleMap.begin(); it != circleMap.end();) {
+            if (sqrtOverlap(circleMap[i], *it) &&
+                (it->x != circleMap[i].x || it->y != circleMap[i].y)) {
+                it = circleMap.erase(it);
+                length--;
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto element : circleMap) {
+        Coordinate c;
+        c.x = element.x;
+        c.y = element.y;
+        availableLocations.push_back(c);
+    }
+}
+}
+
+// The reference reads one column past either side of the map, so it gets
+// a padded copy where those reads land on empty tiles
+struct PaddedMap {
+    Tile storage[MAP_WIDTH + 2][MAP_HEIGHT];
+    Tile (*get())[MAP_HEIGHT] { return storage + 1; }
+};
+
+// generateMap() with the stream the game draws from, copied out to an array
+// like the reference's
+static int currentGenerateMap(Tile map[MAP_WIDTH][MAP_HEIGHT]) {
+    static TileMap tileMap;
+    int overlayRetries = 0;
+    const int count =
+        generateMap(tileMap, rng::get(rng::Stream::mapgen), overlayRetries);
+    std::memcpy(map, tileMap.data(), sizeof(Tile) * MAP_WIDTH * MAP_HEIGHT);
+    return count;
+}
+
+using MapGenerator = int (*)(Tile[MAP_WIDTH][MAP_HEIGHT]);
+
+static void generateLevel(MapGenerator generator,
+                          Tile map[MAP_WIDTH][MAP_HEIGHT],
+                          int level) {
+    rng::reseed(rng::Stream::mapgen, level);
+    int count;
+    do {
+        count = generator(map);
+    } while (count < 150);
+}
+
+static bool verify(int levels) {
+    PaddedMap expected{}, actual{};
+    for (int level = 1; level <= levels; level++) {
+        generateLevel(reference::generateMap, expected.get(), level);
+        const uint32_t expectedNext = rng::get(rng::Stream::mapgen)();
+        generateLevel(currentGenerateMap, actual.get(), level);
+        const uint32_t actualNext = rng::get(rng::Stream::mapgen)();
+        if (std::memcmp(expected.storage, actual.storage,
+                        sizeof expected.storage) != 0 ||
+            expectedNext != actualNext) {
+            std::cerr << "mapbench: level " << level
+                      << " differs from the reference" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static double levelsPerSecond(MapGenerator generator, int levels) {
+    PaddedMap map{};
+    const auto start = std::chrono::steady_clock::now();
+    for (int level = 1; level <= levels; level++) {
+        generateLevel(generator, map.get(), level);
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return levels / elapsed.count();
+}
+
+using Placement = void (*)(LevelLayout &, rng::Generator &);
+
+static Circle teleporterFootprint(const LevelLayout & layout) {
+    Circle footprint;
+    footprint.x = layout.teleporter.x;
+    footprint.y = layout.teleporter.y;
+    footprint.r = 50;
+    return footprint;
+}
+
+static void referencePlacement(LevelLayout & layout,
+                               rng::Generator & generator) {
+    Circle footprint = teleporterFootprint(layout);
+    layout.rockPositions.clear();
+    reference::placeCircles(layout.map, layout.rockPositions, footprint,
+                            generator, PILLAR_RADIUS, 60, false);
+    layout.lightPositions.clear();
+    reference::placeCircles(layout.map, layout.lightPositions, footprint,
+                            generator, CIRC_RADIUS, 40, true);
+}
+
+static void currentPlacement(LevelLayout & layout,
+                             rng::Generator & generator) {
+    Circle footprint = teleporterFootprint(layout);
+    layout.rockPositions.clear();
+    getRockPositions(layout.map, layout.rockPositions, footprint, generator);
+    layout.lightPositions.clear();
+    getLightingPositions(layout.map, layout.lightPositions, footprint,
+                         generator);
+}
+
+static bool samePositions(const std::vector<Coordinate> & a,
+                          const std::vector<Coordinate> & b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const Coordinate & c1, const Coordinate & c2) {
+                          return c1.x == c2.x && c1.y == c2.y;
+                      });
+}
+
+static std::vector<std::unique_ptr<LevelLayout>> generateLayouts(int count) {
+    std::vector<std::unique_ptr<LevelLayout>> layouts;
+    for (int level = 1; level <= count; level++) {
+        layouts.push_back(std::make_unique<LevelLayout>());
+        rng::Generator generator =
+            rng::makeGenerator(rng::Stream::mapgen, level);
+        generateLevelLayout(*layouts.back(), generator);
+    }
+    return layouts;
+}
+
+static bool verifyPlacement(
+    const std::vector<std::unique_ptr<LevelLayout>> & layouts) {
+    LevelLayout expected, actual;
+    for (size_t i = 0; i < layouts.size(); i++) {
+        expected = *layouts[i];
+        actual = *layouts[i];
+        rng::Generator expectedGenerator =
+            rng::makeGenerator(rng::Stream::mapgen, i);
+        rng::Generator actualGenerator = expectedGenerator;
+        referencePlacement(expected, expectedGenerator);
+        currentPlacement(actual, actualGenerator);
+        if (!samePositions(expected.rockPositions, actual.rockPositions) ||
+            !samePositions(expected.lightPositions, actual.lightPositions) ||
+            expectedGenerator() != actualGenerator()) {
+            std::cerr << "mapbench: placement on level " << i + 1
+                      << " differs from the reference" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static double placementsPerSecond(
+    Placement placement,
+    const std::vector<std::unique_ptr<LevelLayout>> & layouts, int count) {
+    LevelLayout layout = *layouts.front();
+    rng::Generator generator = rng::makeGenerator(rng::Stream::mapgen, 0);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        // Only the map and the teleporter are read
+        const LevelLayout & source = *layouts[i % layouts.size()];
+        layout.map = source.map;
+        layout.teleporter = source.teleporter;
+        placement(layout, generator);
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return count / elapsed.count();
+}
+
+int main(int argc, char ** argv) {
+    const int levels = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (levels <= 0) {
+        std::cerr << "usage: mapbench [LEVELS]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    rng::seed(0);
+    if (!verify(200)) {
+        return EXIT_FAILURE;
+    }
+    const double before = levelsPerSecond(reference::generateMap, levels);
+    const double after = levelsPerSecond(currentGenerateMap, levels);
+    std::cout << "reference: " << before << " levels/s" << std::endl;
+    std::cout << "generateMap: " << after << " levels/s (" << after / before
+              << "x)" << std::endl;
+    const auto layouts = generateLayouts(200);
+    if (!verifyPlacement(layouts)) {
+        return EXIT_FAILURE;
+    }
+    const double placementBefore =
+        placementsPerSecond(referencePlacement, layouts, levels);
+    const double placementAfter =
+        placementsPerSecond(currentPlacement, layouts, levels);
+    std::cout << "reference placement: " << placementBefore << " levels/s"
+              << std::endl;
+    std::cout << "selectSpacedCircles: " << placementAfter << " levels/s ("
+              << placementAfter / placementBefore << "x)" << std::endl;
+}
@@ -0,0 +1,251 @@
+// mapgen: generates seeded levels on every core, the same way the game does,
+// and reports how long they took and what came out.
+//
+//   mapgen [--levels N] [--seed S] [--threads T] [--dump FILE]
+//
+// Level n is built from the mapgen stream reseeded with n, so a level here is
+// tile for tile the level the game builds for that run seed. With --dump, the
+// maps are written to FILE as:
+//
+//   "BJMP" | u32 version | u64 seed | u32 count
+//   then per level: u32 level | u16 width, height | u16 teleporter x, y |
+//                   u16 spawn x, y | width * height tile bytes, column by
+//                   column
+//
+// All fields are little endian.
+
+#include "../src/framework/workerPool.hpp"
+#include "../src/levelGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static const uint32_t dumpVersion = 2;
+
+static_assert(sizeof(Tile) == 1, "the dump copies tiles byte for byte");
+
+struct Options {
+    int levels = 1000;
+    uint64_t seed = 0;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::string dumpPath;
+};
+
+struct LevelStats {
+    int level;
+    double micros;
+    int mapRetries;
+    int overlayRetries;
+    int walkable;
+    bool reachable;
+    Coordinate teleporter;
+    Coordinate spawn;
+    TileMap map;
+};
+
+static bool parseOptions(int argc, char ** argv, Options & options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--levels" && i + 1 < argc) {
+            options.levels = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            const int threads = std::atoi(argv[++i]);
+            if (threads <= 0) {
+                return false;
+            }
+            options.threads = threads;
+        } else if (arg == "--dump" && i + 1 < argc) {
+            options.dumpPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.levels > 0;
+}
+
+// Walks the walkable tiles from the spawn point, four ways, like the player
+static bool isReachable(const LevelLayout & layout) {
+    const TileMap & map = layout.map;
+    Grid<uint8_t> visited(map.getWidth(), map.getHeight());
+    std::queue<Coordinate> frontier;
+    frontier.push(layout.spawn);
+    visited(layout.spawn.x, layout.spawn.y) = true;
+    static const int offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    while (!frontier.empty()) {
+        const Coordinate c = frontier.front();
+        frontier.pop();
+        if (c.x == layout.teleporter.x && c.y == layout.teleporter.y) {
+            return true;
+        }
+        for (const auto & offset : offsets) {
+            const int x = c.x + offset[0];
+            const int y = c.y + offset[1];
+            if (map.contains(x, y) && !visited(x, y) &&
+                isTileWalkable(map(x, y))) {
+                visited(x, y) = true;
+                frontier.push({x, y, 0});
+            }
+        }
+    }
+    return false;
+}
+
+static LevelStats generateLevel(int level, bool keepTiles) {
+    // About 11K, too big to keep on a worker's stack
+    auto layout = std::make_unique<LevelLayout>();
+    rng::Generator generator = rng::makeGenerator(rng::Stream::mapgen, level);
+    const auto start = std::chrono::steady_clock::now();
+    generateLevelLayout(*layout, generator);
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    LevelStats stats;
+    stats.level = level;
+    stats.micros = elapsed.count();
+    stats.mapRetries = layout->mapRetries;
+    stats.overlayRetries = layout->overlayRetries;
+    stats.walkable = 0;
+    for (int i = 0; i < layout->map.getWidth(); i++) {
+        for (int j = 0; j < layout->map.getHeight(); j++) {
+            stats.walkable += isTileWalkable(layout->map(i, j));
+        }
+    }
+    stats.reachable = isReachable(*layout);
+    stats.teleporter = layout->teleporter;
+    stats.spawn = layout->spawn;
+    if (keepTiles) {
+        stats.map = std::move(layout->map);
+    }
+    return stats;
+}
+
+template <typename T> static void writeLE(std::ofstream & file, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        file.put(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+static void writeDump(const std::string & path, uint64_t seed,
+                      const std::vector<LevelStats> & levels) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("mapgen: unable to create " + path);
+    }
+    file.write("BJMP", 4);
+    writeLE<uint32_t>(file, dumpVersion);
+    writeLE<uint64_t>(file, seed);
+    writeLE<uint32_t>(file, levels.size());
+    for (const auto & stats : levels) {
+        writeLE<uint32_t>(file, stats.level);
+        writeLE<uint16_t>(file, stats.map.getWidth());
+        writeLE<uint16_t>(file, stats.map.getHeight());
+        writeLE<uint16_t>(file, stats.teleporter.x);
+        writeLE<uint16_t>(file, stats.teleporter.y);
+        writeLE<uint16_t>(file, stats.spawn.x);
+        writeLE<uint16_t>(file, stats.spawn.y);
+        file.write(reinterpret_cast<const char *>(stats.map.data()),
+                   stats.map.size());
+    }
+    if (!file) {
+        throw std::runtime_error("mapgen: error writing " + path);
+    }
+}
+
+template <typename F>
+static void reportRange(const char * name,
+                        const std::vector<LevelStats> & levels, F field) {
+    double sum = 0;
+    int min = field(levels.front()), max = min;
+    for (const auto & stats : levels) {
+        const int value = field(stats);
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    std::cout << name << ": mean " << sum / levels.size() << ", min " << min
+              << ", max " << max << std::endl;
+}
+
+static void report(const std::vector<LevelStats> & levels, double wallSeconds) {
+    std::vector<double> times;
+    for (const auto & stats : levels) {
+        times.push_back(stats.micros);
+    }
+    std::sort(times.begin(), times.end());
+    const auto percentile = [&times](int p) {
+        return times[std::min(times.size() - 1, times.size() * p / 100)];
+    };
+    std::cout << levels.size() << " levels in " << wallSeconds << "s ("
+              << levels.size() / wallSeconds << " levels/s)" << std::endl;
+    std::cout << "time per level (us): p50 " << percentile(50) << ", p90 "
+              << percentile(90) << ", p99 " << percentile(99) << ", max "
+              << times.back() << std::endl;
+    reportRange("map retries (< 150 center tiles)", levels,
+                [](const LevelStats & s) { return s.mapRetries; });
+    reportRange("overlay retries (< 300 plates)", levels,
+                [](const LevelStats & s) { return s.overlayRetries; });
+    reportRange("walkable tiles", levels,
+                [](const LevelStats & s) { return s.walkable; });
+    std::vector<int> unreachable;
+    for (const auto & stats : levels) {
+        if (!stats.reachable) {
+            unreachable.push_back(stats.level);
+        }
+    }
+    std::cout << "teleporter reachable from spawn: "
+              << levels.size() - unreachable.size() << "/" << levels.size()
+              << std::endl;
+    if (!unreachable.empty()) {
+        std::cout << "unreachable levels:";
+        for (size_t i = 0; i < unreachable.size() && i < 20; ++i) {
+            std::cout << " " << unreachable[i];
+        }
+        std::cout << (unreachable.size() > 20 ? " ..." : "") << std::endl;
+    }
+}
+
+int main(int argc, char ** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: mapgen [--levels N] [--seed S] [--threads T] "
+                     "[--dump FILE]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    rng::seed(options.seed);
+    try {
+        const bool keepTiles = !options.dumpPath.empty();
+        std::vector<LevelStats> levels;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            WorkerPool pool(options.threads);
+            std::vector<std::future<LevelStats>> pending;
+            for (int level = 1; level <= options.levels; ++level) {
+                pending.push_back(pool.submit([level, keepTiles] {
+                    return generateLevel(level, keepTiles);
+                }));
+            }
+            for (auto & result : pending) {
+                levels.push_back(result.get());
+            }
+        }
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        report(levels, elapsed.count());
+        if (keepTiles) {
+            writeDump(options.dumpPath, options.seed, levels);
+        }
+    } catch (const std::exception & ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
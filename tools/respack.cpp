@@ -0,0 +1,149 @@
+// respack: bundles resource files into the archive read by ResourceArchive.
+//
+//   respack OUTPUT ROOT [--raw] FILE...
+//
+// FILE paths are relative to ROOT, and become the entry names. With --raw,
+// textures and sound effects are stored decoded, so that the game can hand
+// them to SFML without decoding anything at startup. Music is always stored
+// as is, because it gets streamed.
+
+#include "../src/resourceArchive.hpp"
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct PackedEntry {
+    ArchiveEntry entry;
+    std::vector<char> data;
+};
+
+static bool startsWith(const std::string & str, const char * prefix) {
+    return str.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+static std::vector<char> readFile(const std::string & path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("respack: unable to open " + path);
+    }
+    return std::vector<char>(std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>());
+}
+
+static PackedEntry packFile(const std::string & root, const std::string & name,
+                            bool raw) {
+    if (name.size() >= sizeof(ArchiveEntry::name)) {
+        throw std::runtime_error("respack: name too long: " + name);
+    }
+    PackedEntry packed{};
+    std::strcpy(packed.entry.name, name.c_str());
+    packed.entry.format = ArchiveFormat::Encoded;
+    const std::string path = root + "/" + name;
+    if (raw && startsWith(name, "textures/")) {
+        sf::Image image;
+        if (!image.loadFromFile(path)) {
+            throw std::runtime_error("respack: unable to decode " + path);
+        }
+        const sf::Vector2u size = image.getSize();
+        const char * pixels =
+            reinterpret_cast<const char *>(image.getPixelsPtr());
+        packed.entry.format = ArchiveFormat::RawRGBA;
+        packed.entry.params[0] = size.x;
+        packed.entry.params[1] = size.y;
+        packed.data.assign(pixels, pixels + size.x * size.y * 4);
+    } else if (raw && startsWith(name, "sounds/")) {
+        sf::InputSoundFile file;
+        if (!file.openFromFile(path)) {
+            throw std::runtime_error("respack: unable to decode " + path);
+        }
+        std::vector<sf::Int16> samples(
+            static_cast<size_t>(file.getSampleCount()));
+        samples.resize(static_cast<size_t>(
+            file.read(samples.data(), samples.size())));
+        const char * bytes = reinterpret_cast<const char *>(samples.data());
+        packed.entry.format = ArchiveFormat::RawPCM;
+        packed.entry.params[0] = file.getChannelCount();
+        packed.entry.params[1] = file.getSampleRate();
+        packed.data.assign(bytes,
+                           bytes + samples.size() * sizeof(sf::Int16));
+    } else {
+        packed.data = readFile(path);
+    }
+    packed.entry.size = packed.data.size();
+    return packed;
+}
+
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + archiveAlignment - 1) & ~(archiveAlignment - 1);
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 4) {
+        std::cerr << "usage: respack OUTPUT ROOT [--raw] FILE..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string output = argv[1];
+    const std::string root = argv[2];
+    int first = 3;
+    bool raw = false;
+    if (std::strcmp(argv[first], "--raw") == 0) {
+        raw = true;
+        ++first;
+    }
+    try {
+        std::vector<PackedEntry> entries;
+        for (int i = first; i < argc; ++i) {
+            entries.push_back(packFile(root, argv[i], raw));
+        }
+        ArchiveHeader header{};
+        std::memcpy(header.magic, "BJRA", 4);
+        header.version = archiveVersion;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        uint64_t offset = alignUp(sizeof(ArchiveHeader) +
+                                  entries.size() * sizeof(ArchiveEntry));
+        for (auto & packed : entries) {
+            packed.entry.offset = offset;
+            offset = alignUp(offset + packed.entry.size);
+        }
+        std::ofstream file(output, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("respack: unable to create " + output);
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof header);
+        for (const auto & packed : entries) {
+            file.write(reinterpret_cast<const char *>(&packed.entry),
+                       sizeof packed.entry);
+        }
+        // FNV-1a over the blobs, so that two builds of the archive can be
+        // compared at a glance
+        uint64_t checksum = 14695981039346656037ull;
+        for (const auto & packed : entries) {
+            const std::streamoff padding =
+                static_cast<std::streamoff>(packed.entry.offset) -
+                file.tellp();
+            for (std::streamoff i = 0; i < padding; ++i) {
+                file.put('\0');
+            }
+            file.write(packed.data.data(), packed.data.size());
+            for (char byte : packed.data) {
+                checksum ^= static_cast<uint8_t>(byte);
+                checksum *= 1099511628211ull;
+            }
+        }
+        if (!file) {
+            throw std::runtime_error("respack: error writing " + output);
+        }
+        std::cout << "respack: " << entries.size() << " entries, "
+                  << file.tellp() << " bytes, checksum " << std::hex << checksum << std::endl;
+    } catch (const std::exception & ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}